@@ -0,0 +1,55 @@
+/**
+ * @file AccessTrace.h
+ * @brief Synthetic file access trace for disk defragmentation simulation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file contains the AccessTrace class which measures what a layout
+ * costs the workload using the drive. The trace is a fixed sequence of file
+ * accesses, each file drawn as often as its access heat says (see
+ * FileManager::getAccessHeat). Replaying it reads every block of each file
+ * in disk order, wherever the file is at the time, so the same trace
+ * replayed before and after defragmenting shows how far the head travels
+ * less, and how much time the drive saves, with the new layout.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "Config.h"
+#include "Enums.h"
+#include "GridManager.h"
+
+// Cost of one replay of the trace
+struct TraceReplay {
+  uint64_t seekDistance;  // Distance travelled by the head (in clusters)
+  uint64_t diskTime;  // Time the reads take on the drive (in microseconds)
+
+  // Constructor
+  TraceReplay();
+};
+
+// Synthetic file access trace class
+class AccessTrace {
+private:
+  std::vector<int> fileIDs;  // Files accessed, in trace order
+
+  // Collect the cells of the movable data of each file (in disk order)
+  static void collectFileCells(const GridManager& gridManager, std::map<int, std::vector<int>>& fileCells);
+
+public:
+  // Constructor (empty trace)
+  AccessTrace();
+
+  // Draw the trace from the files on the drive (Config::Placement::TRACE_LENGTH accesses)
+  void generate(const GridManager& gridManager);
+
+  // Replay the trace on a layout, charged to the configured timing model of the drive
+  TraceReplay replay(const GridManager& gridManager) const;
+
+  // Get whether the trace holds no access
+  bool isEmpty() const;
+};
@@ -16,6 +16,7 @@
 #include "Config.h"
 #include "Enums.h"
 #include "GridManager.h"
+#include "ExplosionParticles.h"
 
 // Animation management class
 class AnimationManager {
@@ -28,13 +29,19 @@ private:
   int driveInfoPhase2ScanX;  // X-coordinate during scanning in reading drive info phase 2
   int driveInfoPhase2ScanY;  // Y-coordinate during scanning in reading drive info phase 2
   bool driveInfoPhase2ScanCompleted;  // Whether the scan is complete in reading drive info phase 2
+  uint64_t scanBudget;  // Unspent scan budget (in clusters times microseconds)
+  ExplosionParticles explosionParticles;  // Debris of exploded blocks
  
   // Collect positions of moving and reading blocks
   void collectMovingAndReadingBlocks(std::vector<std::pair<int, int>>& movingBlockPositions, 
                                     std::vector<std::pair<int, int>>& readingBlockPositions);
   
-  // Update all blocks
-  void updateAllBlocks();
+  // Sweep the clusters one tick of scan budget allows, updating each with updateState
+  // (returns true when the whole grid has been scanned)
+  bool scanClusters(int& scanX, int& scanY, void (Block::*updateState)());
+  
+  // Update all blocks (one tick ending at simulated time now)
+  void updateAllBlocks(uint64_t now);
   
   // Process blocks that have completed movement
   bool processCompletedBlocks(const std::vector<std::pair<int, int>>& movingBlockPositions, 
@@ -53,8 +60,20 @@ public:
   // Block update process in reading drive info phase 2
   void updateBlocksInDriveInfoPhase2();
 
-  // Block update process in defragmenting
-  void updateBlocksInDefragmenting();
+  // Block update process in defragmenting (now: simulated time in microseconds)
+  void updateBlocksInDefragmenting(uint64_t now);
+  
+  // Turn all visible blocks into explosion debris (from touch coordinates)
+  void startExplosion(int touchX, int touchY);
+  
+  // Update explosion animation
+  void updateExplosion();
+  
+  // Get whether all explosion debris has left the screen
+  bool isExplosionFinished() const;
+  
+  // Get explosion debris
+  const ExplosionParticles& getExplosionParticles() const;
   
   // Update defrag step
   void incrementDefragStep();
@@ -0,0 +1,62 @@
+/**
+ * @file AudioScheduler.h
+ * @brief Asynchronous sound event scheduler
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the AudioScheduler class which decouples sound output
+ * from the simulation. The simulation posts sound events to a lock-free
+ * queue and a background task plays them on the speaker, so neither the
+ * simulation nor the render loop ever waits on audio. Samples are played on
+ * a pool of speaker channels (voices) which the speaker mixes, so
+ * overlapping effects are heard together.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Config.h"
+#include "SpscQueue.h"
+#include "BackgroundTask.h"
+
+// Sound event (one pre-rendered sample on a free voice)
+struct SoundEvent {
+  const std::vector<int16_t>* sample;  // PCM sample (must outlive the playback, see SoundSampleCache)
+  uint32_t gapAfter;  // Pause before the next event is played (in milliseconds)
+};
+
+// Audio scheduler class
+class AudioScheduler {
+private:
+  SpscQueue<SoundEvent, Config::Sound::Scheduler::QUEUE_SIZE> queue;  // Events posted by the simulation
+  BackgroundTask task;  // Task playing the queued events
+  uint32_t droppedEvents;  // Number of events dropped because the queue was full
+  int nextVoice;  // Voice tried first by the next playback (audio task only)
+
+  // Audio task main loop
+  static void taskMain(void* scheduler);
+  
+  // Play a sample on a free voice, or on the oldest voice if all are busy (audio task only)
+  void playOnVoice(const std::vector<int16_t>& sample);
+
+public:
+  // Constructor
+  AudioScheduler();
+
+  // Start the audio task (does nothing if already running)
+  void start();
+
+  // Stop the audio task (queued events stay in the queue)
+  void stop();
+
+  // Get whether the audio task is running
+  bool isRunning() const;
+
+  // Queue a sound event (returns false and drops the event if the queue is full)
+  bool post(const SoundEvent& event);
+
+  // Get the number of events dropped because the queue was full
+  uint32_t getDroppedEventCount() const;
+};
@@ -0,0 +1,67 @@
+/**
+ * @file BackgroundTask.h
+ * @brief Background task abstraction for M5Stack and native environments
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the BackgroundTask class which runs a function
+ * concurrently with the main loop: as a FreeRTOS task pinned to a core on
+ * M5Stack, and as a std::thread in the native PC/SDL environment. The
+ * function polls isStopRequested() and returns when asked to stop.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <thread>
+#endif
+
+// Background task class
+class BackgroundTask {
+public:
+  // Function run by the task (argument: pointer passed to start)
+  typedef void (*TaskFunction)(void* argument);
+
+private:
+  TaskFunction function;
+  void* argument;
+  std::atomic<bool> stopRequested;  // Whether the function should return
+  std::atomic<bool> running;  // Whether the function has not returned yet
+#ifdef ARDUINO
+  TaskHandle_t handle;
+#else
+  std::thread thread;
+#endif
+
+  // Task entry point (runs the function, then marks the task finished)
+  static void entry(void* task);
+
+public:
+  // Constructor
+  BackgroundTask();
+
+  // Destructor
+  ~BackgroundTask();
+
+  // Start the task (core: CPU core on M5Stack, -1 for any; ignored in the native build)
+  bool start(const char* name, int core, int priority, uint32_t stackSize,
+             TaskFunction taskFunction, void* taskArgument);
+
+  // Ask the task to stop and wait until its function has returned
+  void stop();
+
+  // Get whether the task is running
+  bool isRunning() const;
+
+  // Get whether the task has been asked to stop (polled by the task function)
+  bool isStopRequested() const;
+
+  // Sleep the calling task or thread (in milliseconds)
+  static void sleepFor(uint32_t milliseconds);
+};
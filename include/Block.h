@@ -16,9 +16,8 @@
 #include "Config.h"
 #include "Colors.h"
 #include "Enums.h"
-
-// Canvas for off-screen rendering (external declaration)
-extern M5Canvas canvas;
+#include "FixedPoint.h"
+#include "RenderTarget.h"
 
 // Block class
 class Block {
@@ -27,10 +26,12 @@ public:
   int x, y;  // Position on the grid
   int fileID;  // ID of blocks belonging to the same file
   int targetX, targetY;  // Target position (for animation)
-  float animX, animY; // Floating-point coordinates for animation
+  fixed_t animX, animY; // Fixed-point coordinates for animation
+  fixed_t prevAnimX, prevAnimY; // Animation coordinates at the previous tick (for interpolation)
+  fixed_t startAnimX, startAnimY; // Animation coordinates where the movement started
+  int moveTick;  // Number of ticks the block has moved so far (index into the easing table)
   bool isMoving;  // Whether it's moving
-  bool isExploding;  // Whether it's exploding
-  float explodeVelocityX, explodeVelocityY; // Explosion velocity vector
+  uint64_t moveStartTime;  // Simulated time at which the movement starts (in microseconds)
   
   // Constructor
   Block(int _x, int _y);
@@ -38,8 +39,14 @@ public:
   // Get the color based on the block's state
   uint16_t getColor() const;
   
-  // Draw the block
-  void draw(AnimationState animState);
+  // Get the color of a block state
+  static uint16_t getStateColor(BlockState blockState);
+  
+  // Draw a block in the given state at grid coordinates (fractional while moving)
+  static void draw(RenderTarget& target, BlockState blockState, float gridX, float gridY);
+  
+  // Draw a bad block at screen coordinates
+  static void drawBadBlock(RenderTarget& target, int screenX, int screenY);
   
   // Update the block's state in reading drive info phase 1
   void updateStateInDriveInfoPhase1();
@@ -47,15 +54,12 @@ public:
   // Update the block's state in reading drive info phase 2
   void updateStateInDriveInfoPhase2();
 
-  // Start moving
-  void startMoving(int newX, int newY);
-  
-  // Update moving animation in defragmenting
-  void updateMoving();
+  // Start moving from (fromX, fromY) to (newX, newY) (the block waits at its start position until startTime)
+  void startMoving(int fromX, int fromY, int newX, int newY, uint64_t startTime);
   
-  // Start explosion (from center coordinates)
-  void startExploding(int centerX, int centerY);
+  // Update moving animation in defragmenting (one tick ending at simulated time now)
+  void updateMoving(uint64_t now);
   
-  // Update explosion animation
-  void updateExplosion();
+  // Get whether the block explodes when the screen is touched
+  bool canExplode() const;
 };
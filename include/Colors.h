@@ -46,4 +46,21 @@ namespace Colors {
     constexpr uint16_t PROGRESS_BLOCK = 0x0210;  // Color for progress bar block
     constexpr uint16_t HIT_COUNTER = 0xF800;     // Color for hit counter text
   }
+
+  // Palette for indexed canvas modes (every distinct color used above)
+  namespace Palette {
+    constexpr uint16_t ENTRIES[] = {
+      0xFFFF,  // White (free space, backgrounds, highlights)
+      0x0000,  // Black (frames, shadows, text)
+      0xF800,  // Red (fixed/bad markers, writing, hit counter)
+      0x161F,  // Blue (optimized data)
+      0x07FF,  // Cyan (unoptimized data, beginning of drive)
+      0x0430,  // Teal (unoptimized data, middle of drive)
+      0x0210,  // Dark teal (unoptimized data, end of drive, progress blocks)
+      0x07E0,  // Green (reading)
+      0xC618,  // Gray (window and button background)
+      0x0010   // Navy (title bar)
+    };
+    constexpr int COUNT = sizeof(ENTRIES) / sizeof(ENTRIES[0]);
+  }
 }
@@ -0,0 +1,118 @@
+/**
+ * @file CompactionPlanner.h
+ * @brief Whole-disk compaction planning for disk defragmentation simulation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file contains the CompactionPlanner class which analyzes the whole
+ * layout once and computes the complete ordered list of file moves that
+ * leaves every file contiguous and all data packed at the beginning of the
+ * drive, around the fixed blocks (no file spans a fixed block). In the
+ * default layout files and optimized blocks that are already where the
+ * compacted layout needs them stay in place, so only the rest moves; the
+ * sliding layout keeps the data in disk order instead, and the hot/cold
+ * layout orders it by access heat so the most accessed files sit together
+ * on the fast outer tracks.
+ */
+
+#pragma once
+
+#include <vector>
+#include "Config.h"
+#include "Enums.h"
+#include "GridManager.h"
+#include "FileManager.h"
+
+// Whole-disk compaction planner class
+class CompactionPlanner {
+public:
+  // Layout of the compacted data
+  enum class Layout {
+    FEWEST_MOVES,  // Data already in place stays, the rest fills the gaps
+    SLIDING,       // All data slides towards the beginning, keeping its disk order
+    HOT_COLD       // Data is packed from the beginning, hottest files first (see FileManager::getAccessHeat)
+  };
+
+private:
+  // Data that moves as one piece (a fragmented file or a single optimized block)
+  struct Unit {
+    int fileID;  // File ID of the blocks
+    std::vector<int> cells;  // Current cells of the blocks (in disk order)
+    std::vector<int> targetCells;  // Cells of the blocks in the compacted layout
+    bool isFile;  // Whether the unit is a file (false: a single optimized block)
+    bool pinned;  // Whether the unit already is where the compacted layout needs it
+  };
+
+  GridManager& gridManager;
+  FileManager& fileManager;
+  Layout layout;
+  std::vector<Unit> units;  // All data on the drive
+  std::vector<int> slotCells;  // Cells that can hold data (not fixed), in disk order
+  std::vector<int> cellSlots;  // Slot index of each cell (-1: fixed)
+  std::vector<int> slotOwners;  // Unit assigned to each slot (-1: none)
+  int regionSize;  // Number of slots up to the last one holding data once compacted
+
+  // Collect files and optimized blocks, and the slots they can occupy
+  void collectUnits();
+
+  // Get whether count slots from firstSlot are consecutive cells (no fixed block between them)
+  bool isContiguous(int firstSlot, int count) const;
+
+  // Keep units that already lie contiguously inside the compacted region
+  void pinUnits();
+
+  // Keep a unit where it is (it has no room to move to)
+  void keepInPlace(int unitIndex);
+
+  // Assign a run of slots to a unit
+  void assignSlots(int unitIndex, int firstSlot);
+
+  // Find the first free run of count consecutive cells before endSlot (returns -1 if there is none)
+  int findFreeRun(int count, int endSlot) const;
+
+  // Free a run of count slots by unpinning the fewest blocks (returns -1 if there is none)
+  int makeFreeRun(int count, std::vector<int>& unpinnedUnits);
+
+  // Decide where every unit that is not pinned goes
+  void assignTargets();
+
+  // Slide every unit towards the beginning in disk order (units that do not move are pinned)
+  void assignSlidingTargets();
+
+  // Pack the units from the beginning by falling access heat (units that do not move are pinned)
+  void assignHotColdTargets();
+
+  // Assign the first gap before nextSlot that holds a unit, or else the first run of consecutive cells
+  // from nextSlot (advancing nextSlot past it)
+  void assignNextSlots(int unitIndex, int& nextSlot);
+
+  // Extend the compacted region to the last assigned slot (files that fit in no run of it go behind it)
+  void extendRegion();
+
+  // Get whether a move of a unit has to wait until a cell is free
+  bool isWaitingFor(const Unit& unit, int cell) const;
+
+  // Order the moves so that each one only writes to free cells
+  void orderMoves(std::vector<PlannedMove>& moves);
+
+  // Get whether a unit can move to its target cells now
+  bool isReady(const Unit& unit) const;
+
+  // Find free cells outside the compacted region to park a unit (returns false if there are too few)
+  bool findParkingCells(int count, std::vector<int>& parkingCells) const;
+
+  // Add a move of a unit to cells and apply it to the grid
+  void addMove(Unit& unit, const std::vector<int>& toCells, std::vector<PlannedMove>& moves);
+
+  // Convert a cell index to grid coordinates
+  std::pair<int, int> toPosition(int cell) const;
+
+public:
+  // Constructor (plans on gridManager, which ends up in the compacted layout)
+  CompactionPlanner(GridManager& gridManager, FileManager& fileManager, Layout layout = Layout::FEWEST_MOVES);
+
+  // Plan all moves of the compaction
+  // Files already in place come first as one move without targets (optimized in place)
+  void plan(std::vector<PlannedMove>& moves);
+};
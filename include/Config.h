@@ -12,7 +12,15 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include "Enums.h"
+#include "FixedPoint.h"
+
+// Height of a render band in pixels (0 renders the whole screen at once)
+#ifndef DEFRAG_RENDER_BAND_HEIGHT
+#define DEFRAG_RENDER_BAND_HEIGHT 0
+#endif
 
 // Configuration singleton class for the defragmentation simulator
 class Config {
@@ -37,6 +45,16 @@ public:
     static Config* getInstance();
     void initialize(int width, int height);
     
+    // ========================================
+    // Screen configuration
+    // ========================================
+    
+    // Screen width (in pixels)
+    static int getScreenWidth();
+    
+    // Screen height (in pixels)
+    static int getScreenHeight();
+    
     // ========================================
     // Grid configuration
     // ========================================
@@ -92,33 +110,210 @@ public:
     // Spacing between progress blocks (in pixels)
     static int getProgressBarBlockSpacing();
     
+    // ========================================
+    // Render configuration
+    // ========================================
+    struct Render {
+        // Color depth of the off-screen canvas (in bits)
+        // 16: direct RGB565, 8 or 4: palettized (see Colors::Palette)
+        static constexpr int CANVAS_COLOR_DEPTH = 4;
+        
+        // Height of the strip buffer for band rendering (in pixels)
+        // 0: full-screen canvas, otherwise the scene is drawn and pushed band by band
+        static constexpr int BAND_HEIGHT = DEFRAG_RENDER_BAND_HEIGHT;
+        
+        // Whether to alternate two canvases so that drawing overlaps the DMA transfer
+        static constexpr bool DOUBLE_BUFFER = true;
+        
+        // Number of threads rasterizing blocks in horizontal tiles (native build only)
+        // 1: serial rasterization
+        static constexpr int RASTER_THREADS = 4;
+    };
+    
     // ========================================
     // Animation configuration
     // ========================================
     struct Animation {
-        // Block movement speed coefficient
-        static constexpr float MOVE_SPEED = 0.7f;
+        // Simulation tick interval (in microseconds, 30 ticks per second)
+        // All per-tick values below are independent of the display frame rate
+        static constexpr uint32_t TICK_INTERVAL = 33333;
+        
+        // Maximum number of ticks caught up after a slow frame (older time is dropped)
+        static constexpr int MAX_CATCH_UP_TICKS = 4;
+        
+        // Block movement speed coefficient (fraction of the remaining distance per tick, Q16.16)
+        // The easing table of block movements is built from it
+        static constexpr fixed_t MOVE_SPEED = FixedPoint::fromFloat(0.7f);
         
-        // Position threshold (differences below this are ignored)
-        static constexpr float POSITION_THRESHOLD = 0.05f;
+        // Number of entries in the easing table (ticks until a movement snaps to its target)
+        static constexpr int EASING_TICKS = 16;
         
-        // Gravity acceleration during explosion
-        static constexpr float GRAVITY = 0.4f;
+        // Position threshold (differences below this are ignored, Q16.16 grid units)
+        static constexpr fixed_t POSITION_THRESHOLD = FixedPoint::fromFloat(0.05f);
         
-        // Defrag step interval (in frames)
+        // Gravity acceleration during explosion (per tick, Q16.16 grid units)
+        static constexpr fixed_t GRAVITY = FixedPoint::fromFloat(0.4f);
+        
+        // Analysis scan throughput of reading drive info phases 1 and 2 (clusters per second of simulated time)
+        // Each tick sweeps as many clusters as its share of this budget allows, whatever the disk size
+        static constexpr uint32_t SCAN_CLUSTERS_PER_SECOND = 1200;
+        
+        // Defrag step interval (in ticks)
         static constexpr int DEFRAG_STEP_INTERVAL = 10;
         
-        // Block movement delay time (in milliseconds)
+        // Delay between the movement starts of consecutive blocks of a file
+        // (in milliseconds of simulated time; the simulation never sleeps)
         static constexpr int BLOCK_MOVE_DELAY = 5;
         
         // Wait time until reset (in milliseconds)
         static constexpr int RESET_DELAY = 3000;
     };
     
+    // ========================================
+    // Scheduler configuration
+    // ========================================
+    struct Scheduler {
+        // Target frame time (in microseconds)
+        static constexpr uint32_t TARGET_FRAME_TIME = 33333;
+        
+        // Maximum number of consecutive frames skipped while the simulation catches up
+        static constexpr int MAX_SKIPPED_FRAMES = 4;
+        
+        // Whether the simulation runs on its own task and hands snapshots to the render loop
+        // false: simulation steps and drawing alternate in loop()
+        static constexpr bool SPLIT_SIMULATION = true;
+        
+        // CPU core of the simulation task (-1: any core; M5Stack only, loop() runs on core 1)
+        static constexpr int SIMULATION_TASK_CORE = 0;
+        
+        // Priority of the simulation task (M5Stack only, below the audio task)
+        static constexpr int SIMULATION_TASK_PRIORITY = 1;
+        
+        // Stack size of the simulation task (in bytes; M5Stack only)
+        static constexpr uint32_t SIMULATION_TASK_STACK_SIZE = 8192;
+    };
+    
+    // ========================================
+    // Input configuration
+    // ========================================
+    struct Input {
+        // Number of events each input queue can hold (power of two)
+        // Input is sampled once per loop() (see InputManager), so a few frames' worth is plenty
+        static constexpr size_t QUEUE_SIZE = 8;
+    };
+    
+    // ========================================
+    // Move planner configuration
+    // ========================================
+    struct Planner {
+        // Strategy choosing the file moves (see DefragStrategy; compare them with the native-benchmark build)
+        // HOT_COLD_COMPACTION puts the most accessed files on the fast outer tracks at the beginning (see Placement)
+        static constexpr DefragStrategyType STRATEGY = DefragStrategyType::WHOLE_DISK_COMPACTION;
+        
+        // Number of heads moving files at the same time (1: one file at a time, planned by STRATEGY)
+        // More heads split the disk into bands of rows, each defragmented first-fit by its own head
+        // (see MultiHeadPlanner; a worker thread per head in the native build, one task on M5Stack)
+        static constexpr int HEAD_COUNT = 1;
+        
+        // Number of file moves planned ahead of the ones animating (power of two)
+        // Enough to fill the staging buffer while the previous batch is copied
+        static constexpr size_t QUEUE_SIZE = 16;
+        
+        // CPU core of the planner task (-1: any core; M5Stack only)
+        static constexpr int TASK_CORE = -1;
+        
+        // Priority of the planner task (M5Stack only, below the simulation task and loop():
+        // it only has to stay one move ahead, and shares the idle priority while it catches up)
+        static constexpr int TASK_PRIORITY = 0;
+        
+        // Stack size of the planner task (in bytes; M5Stack only)
+        static constexpr uint32_t TASK_STACK_SIZE = 6144;
+        
+        // Sleep time of the planner task while the queue is full (in milliseconds)
+        static constexpr uint32_t IDLE_INTERVAL = 5;
+    };
+    
+    // ========================================
+    // Hot/cold placement configuration
+    // ========================================
+    struct Placement {
+        // Accesses per day of the hottest files (see FileManager::getAccessHeat)
+        // The heat of the other files falls off as 1/n over HEAT_LEVELS levels (Zipf distribution)
+        static constexpr int MAX_ACCESS_HEAT = 1000;
+        static constexpr int HEAT_LEVELS = 64;
+        
+        // File accesses in the synthetic trace replayed before and after defragmenting (see AccessTrace)
+        static constexpr int TRACE_LENGTH = 2000;
+        
+        // Random seed of the synthetic trace
+        static constexpr uint32_t TRACE_SEED = 1;
+    };
+    
+    // ========================================
+    // Free-space consolidation configuration
+    // ========================================
+    struct Consolidation {
+        // Whether files slide towards the beginning once defragmented, merging the free space (see ConsolidationPlanner)
+        // Default of each run (can be changed with DefragSimulator::setConsolidationEnabled)
+        // Only the strategies that leave holes between files need it (FIRST_FIT to MOST_FRAGMENTED_FIRST, or
+        // HEAD_COUNT > 1); after the *_COMPACTION strategies the free space is one region already and the pass is skipped
+        static constexpr bool ENABLED = true;
+    };
+    
+    // ========================================
+    // I/O scheduling configuration
+    // ========================================
+    struct Io {
+        // Order in which the block reads and writes of a move are serviced (see IoScheduler)
+        // Blocks start moving in the order their reads are serviced
+        static constexpr IoPolicy POLICY = IoPolicy::ELEVATOR;
+        
+        // Number of queued requests the policy can choose from (1: strictly in queue order)
+        static constexpr int QUEUE_DEPTH = 32;
+    };
+    
+    // ========================================
+    // Disk timing configuration
+    // ========================================
+    struct Disk {
+        // Timing model charged for every block read and write (see DiskModel)
+        static constexpr DiskModelType MODEL = DiskModelType::HDD;
+        
+        // Size of the data one block stands for (in bytes)
+        static constexpr uint32_t BLOCK_BYTES = 256 * 1024;
+        
+        // Spinning disk (the media transfer rate follows from the rotation speed and the blocks per track)
+        struct Hdd {
+            static constexpr int RPM = 7200;  // Rotation speed (in revolutions per minute)
+            static constexpr int BLOCKS_PER_TRACK = 4;  // Blocks on one track (one cylinder per track)
+            static constexpr uint32_t TRACK_TO_TRACK_SEEK = 1000;  // Seek to the next cylinder (in microseconds)
+            static constexpr uint32_t FULL_STROKE_SEEK = 15000;  // Seek across the whole disk (in microseconds)
+            static constexpr uint32_t WRITE_SETTLE_TIME = 300;  // Extra settling after a seek before a write (in microseconds)
+        };
+        
+        // Solid-state drive
+        struct Ssd {
+            static constexpr uint32_t ACCESS_LATENCY = 80;  // Latency of a request that does not continue the previous one (in microseconds)
+            static constexpr uint32_t TRANSFER_RATE = 500;  // Transfer rate (in MB/s)
+        };
+    };
+    
+    // ========================================
+    // Copy engine configuration
+    // ========================================
+    struct Copy {
+        // Blocks the staging buffer of each head holds (see CopyEngine)
+        // 0: each file is copied block by block on its own
+        static constexpr int STAGING_BLOCKS = 32;
+    };
+    
     // ========================================
     // Sound configuration
     // ========================================
     struct Sound {
+        // Speaker volume (set once; each effect's loudness is baked into its samples)
+        static constexpr int SPEAKER_VOLUME = 150;
+        
         // Seek sound configuration
         struct Seek {
             // Base frequency (Hz)
@@ -136,8 +331,11 @@ public:
             // Number of consecutive beep sounds
             static constexpr int BEEP_COUNT = 6;
             
-            // Speaker volume
-            static constexpr int SPEAKER_VOLUME = 10;
+            // Number of pre-rendered click variants (frequency and duration vary)
+            static constexpr int VARIANT_COUNT = 8;
+            
+            // Sample amplitude (fraction of full scale; quiet next to the explosion)
+            static constexpr float GAIN = 10.0f / 150.0f;
         };
         
         // Explosion sound configuration
@@ -148,8 +346,38 @@ public:
             // Explosion sound duration
             static constexpr uint32_t DURATION = 50U;
             
-            // Speaker volume
-            static constexpr int SPEAKER_VOLUME = 150;
+            // Sample amplitude (fraction of full scale)
+            static constexpr float GAIN = 1.0f;
+        };
+        
+        // Sample playback configuration
+        struct Mixer {
+            // Sample rate of the pre-rendered sounds (Hz)
+            static constexpr uint32_t SAMPLE_RATE = 48000;
+            
+            // Number of speaker channels used as voices (mixed by the speaker)
+            static constexpr int VOICE_COUNT = 4;
+            
+            // First speaker channel used as a voice
+            static constexpr int FIRST_CHANNEL = 0;
+        };
+        
+        // Audio scheduler configuration
+        struct Scheduler {
+            // Number of sound events the queue can hold (power of two)
+            static constexpr size_t QUEUE_SIZE = 32;
+            
+            // CPU core of the audio task (-1: any core; M5Stack only)
+            static constexpr int TASK_CORE = 0;
+            
+            // Priority of the audio task (M5Stack only)
+            static constexpr int TASK_PRIORITY = 2;
+            
+            // Stack size of the audio task (in bytes; M5Stack only)
+            static constexpr uint32_t TASK_STACK_SIZE = 3072;
+            
+            // Sleep time of the audio task while the queue is empty (in milliseconds)
+            static constexpr uint32_t IDLE_INTERVAL = 1;
         };
     };
 };
@@ -0,0 +1,46 @@
+/**
+ * @file ConsolidationPlanner.h
+ * @brief Free-space consolidation planning for disk defragmentation simulation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file contains the ConsolidationPlanner class which plans the pass
+ * run once every file is contiguous: files slide towards the beginning of
+ * the drive, keeping their disk order, so the free space left between them
+ * merges into one region at the end. A file that does not fit in front of a
+ * fixed block goes behind it. A file sliding by less than its own length is
+ * moved in pieces no longer than the distance, so no piece writes over
+ * blocks it has not read yet.
+ */
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include "Config.h"
+#include "Enums.h"
+#include "GridManager.h"
+#include "FileManager.h"
+
+// Free-space consolidation planner class
+class ConsolidationPlanner {
+private:
+  const GridManager& gridManager;
+
+  // Find the first cell from firstCell where count cells hold no fixed block (returns lastCell if there is none before it)
+  int findRoom(int firstCell, int lastCell, int count) const;
+
+  // Add the moves sliding the blocks of an extent from sourceCell to targetCell
+  void addSlideMoves(int fileID, int sourceCell, int targetCell, int count, std::vector<PlannedMove>& moves) const;
+
+  // Convert a cell index to grid coordinates
+  std::pair<int, int> toPosition(int cell) const;
+
+public:
+  // Constructor (plans on gridManager without changing it)
+  ConsolidationPlanner(const GridManager& gridManager);
+
+  // Plan all moves of the consolidation (empty if the free space is consolidated already)
+  void plan(std::vector<PlannedMove>& moves) const;
+};
@@ -0,0 +1,58 @@
+/**
+ * @file CopyEngine.h
+ * @brief Buffered copy engine for disk defragmentation simulation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the CopyEngine class which copies files through a
+ * bounded staging buffer in RAM, as real defragmenters do. Planned moves are
+ * staged until the buffer is full; the batch then reads all its blocks and
+ * writes them back in disk order. Since every block of a batch is read before
+ * the first write, a move may write into space that another move of the same
+ * batch frees. A move that reads data written by the current batch starts
+ * the next batch instead, and a file larger than the free room is copied in
+ * parts. Without a buffer each file is copied block by block on its own.
+ */
+
+#pragma once
+
+#include <vector>
+#include "Config.h"
+#include "FileManager.h"
+
+// Buffered copy engine class (one per disk head)
+class CopyEngine {
+private:
+  int capacity;  // Blocks the staging buffer holds (0: no buffer)
+  int columnCount;  // Cells per grid row
+  PlannedMove batch;  // Blocks staged for the next copy (each with its target)
+  std::vector<bool> writtenCells;  // Cells written by the staged batch
+  PlannedMove pendingMove;  // Move (or rest of a move) waiting for the next batch
+  bool hasPendingMove;
+
+  // Stage as many blocks of the pending move as the buffer has room for (returns false if none fit)
+  bool stagePendingMove();
+
+public:
+  // Constructor
+  CopyEngine(int capacity = Config::Copy::STAGING_BLOCKS);
+
+  // Reset for a grid (discards staged blocks; call before staging the first move)
+  void reset(int columnCount, int rowCount);
+
+  // Get whether another move can be staged
+  bool hasRoom() const;
+
+  // Stage a move with targets (what does not fit in this batch waits for the next one)
+  void addMove(const PlannedMove& move);
+
+  // Take the staged batch as one move (returns false if nothing is staged)
+  bool takeBatch(PlannedMove& move);
+
+  // Get whether the batch is copied through the staging buffer (all reads before the writes)
+  bool isStaged() const;
+
+  // Get the number of blocks the staging buffer holds
+  int getCapacity() const;
+};
@@ -19,28 +19,98 @@
 #include "Enums.h"
 #include "GridManager.h"
 #include "FileManager.h"
+#include "MovePlanner.h"
+#include "MultiHeadPlanner.h"
+#include "IoScheduler.h"
+#include "CopyEngine.h"
+#include "ConsolidationPlanner.h"
+#include "AccessTrace.h"
 #include "AnimationManager.h"
 #include "UIRenderer.h"
 #include "SoundManager.h"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
+#include "SpscQueue.h"
+#include "InputManager.h"
 
 // Defrag simulator class
 class DefragSimulator {
 private:
   GridManager gridManager;
   FileManager fileManager;
+  MovePlanner movePlanner;  // Plans the next file moves in the background
+  MultiHeadPlanner multiHeadPlanner;  // Plans the moves of each head (more than one head only)
+  std::vector<PlannedMove> headMoves;  // Batch each head started last
+  std::vector<IoScheduler> ioSchedulers;  // Orders the block reads and writes of each head
+  std::vector<CopyEngine> copyEngines;  // Gathers the moves of each head into batches for its staging buffer
   AnimationManager animationManager;
   UIRenderer uiRenderer;
   SoundManager soundManager;
   
+  // Simulated time (in microseconds, advanced by one tick interval per update)
+  uint64_t simulationTime;
+  
+  // Whether the planner has been started on the scanned grid
+  bool isPlanning;
+  
+  // Whether the planner has no more moves to hand over
+  bool allMovesTaken;
+  
+  // Blocks of the current pass whose copy has started
+  int startedBlockCount;
+  
+  // Free-space consolidation
+  bool consolidationEnabled;  // Whether the next consolidation runs
+  std::vector<PlannedMove> consolidationMoves;  // Moves of the consolidation
+  size_t nextConsolidationMove;  // Index of the next consolidation move to take
+  int consolidationBlockCount;  // Blocks moved by the consolidation
+  
+  // Synthetic access trace replayed before and after defragmenting
+  AccessTrace accessTrace;
+  TraceReplay traceBeforeDefrag;  // Cost of the trace on the layout the defragmentation started from
+  
   // Record the time when completed state is reached
-  unsigned long completedStateStartTime;
+  uint64_t completedStateStartTime;
   bool isInCompletedState;
   
   // Touch detection related
   bool isInTouchState;
-  unsigned long touchStateStartTime;
+  uint64_t touchStateStartTime;
   int touchX, touchY;  // Touched coordinates (grid coordinates)
   
+  // Snapshots handed from the simulation to the renderer
+  TripleBuffer<RenderSnapshot> snapshots;
+  float lastDrawnAlpha;  // Interpolation position of the last drawn frame (rendering side)
+  uint64_t measuredInputTimestamp;  // Input whose latency was measured last (rendering side)
+  
+  // Input events posted by loop(), handled at the start of the next update
+  SpscQueue<InputEvent, Config::Input::QUEUE_SIZE> pendingInputEvents;
+  uint64_t lastInputTimestamp;  // Sampling time of the newest input handled (0: none)
+  
+  // Start the animation from reading drive information
+  void restart();
+  
+  // Get whether the first planned move can be taken without waiting for a whole-drive plan
+  bool isPlannerReady() const;
+  
+  // Take the next planned move of a head (returns false if none is left)
+  bool takeNextMove(int head, PlannedMove& move);
+  
+  // Start the next batch of planned moves of every idle head
+  void startNextMoves();
+  
+  // Advance the copies of the current pass (returns the number of blocks in flight)
+  int updateMoves();
+  
+  // Start consolidating the free space, or complete if it is consolidated already
+  void startConsolidation();
+  
+  // Show the time the copies take on the drive (elapsed, throughput and estimated time left)
+  void updateDiskStatus();
+  
+  // Measure the input-to-photon latency when a snapshot shows a new input for the first time
+  void measureInputLatency(const RenderSnapshot& snapshot);
+  
 public:
   // Constructor
   DefragSimulator();
@@ -51,23 +121,60 @@ public:
   // Reset
   void reset();
   
-  // Update process
+  // Update process (one fixed simulation tick)
   void update();
   
-  // Draw grid and UI elements
-  void draw();
+  // Publish the current state for the renderer (simulation side)
+  void publishSnapshot(bool interpolate);
+  
+  // Draw the latest published snapshot (rendering side, returns false if the screen would not change)
+  bool drawLatestSnapshot();
+  
+  // Publish and draw the current state on the calling thread (alpha: position between the previous and the current tick)
+  void draw(float alpha);
+  
+  // Draw the snapshot drawn last once more (the regression harness draws it through several render setups)
+  void redrawSnapshot(float alpha);
+  
+  // Get the snapshot drawn last
+  const RenderSnapshot& getDrawnSnapshot() const;
+  
+  // Create the canvases and raster threads of a render setup anew (returns false if no canvas fits in memory)
+  bool applyRenderSetup(const RenderSetup& setup);
   
   // Get state
   AnimationState getState() const;
   
+  // Get whether the scan is done and the simulation waits for the planner to begin
+  // (the regression harness waits with it, so its frames do not depend on the planning time)
+  bool isWaitingForPlanner() const;
+  
   // Set state
   void setState(AnimationState newState);
   
   // Process when touch is detected
   void handleTouch(int x, int y);
   
+  // Post an input event from loop() (handled at the start of the next update)
+  void postInputEvent(const InputEvent& event);
+  
   // Explode all blocks
   void setAllBlocksToBAD(int touchX, int touchY);
+  
+  // Get the grid of the simulated drive
+  const GridManager& getGridManager() const;
+  
+  // Enable or disable the free-space consolidation (from the next consolidation on)
+  void setConsolidationEnabled(bool enabled);
+  
+  // Get whether the free-space consolidation is enabled
+  bool isConsolidationEnabled() const;
+  
+  // Enable or disable sound output
+  void setSoundEnabled(bool enabled);
+  
+  // Set the turbo factor shown in the UI
+  void setTurboFactor(int turboFactor);
 };
 
 // Global instance (external declaration)
@@ -0,0 +1,136 @@
+/**
+ * @file DefragStrategy.h
+ * @brief Strategies choosing the file moves of the defragmentation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file contains the DefragStrategy interface and its implementations.
+ * A strategy plans moves on a grid one at a time and applies each move's
+ * result to that grid, so the next move is planned on the grid as it will
+ * be. File-by-file strategies differ in which file they pick and where they
+ * put it; compaction strategies plan the whole drive when they begin.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <utility>
+#include "Config.h"
+#include "Enums.h"
+#include "GridManager.h"
+#include "FileManager.h"
+#include "CompactionPlanner.h"
+
+// Defrag strategy interface
+class DefragStrategy {
+public:
+  // Destructor
+  virtual ~DefragStrategy() {}
+
+  // Get the name of the strategy
+  virtual const char* getName() const = 0;
+
+  // Start planning the moves for the grid the file manager works on
+  virtual void begin(GridManager&, FileManager&) {}
+
+  // Plan the next move and apply its result to the grid (returns false if no move is left)
+  virtual bool planNextMove(GridManager& gridManager, FileManager& fileManager, PlannedMove& move) = 0;
+
+  // Get the number of moves planned by begin (-1: moves are planned one at a time)
+  virtual int getPlannedMoveCount() const { return -1; }
+
+  // Get the number of blocks moved by the moves planned by begin (-1: moves are planned one at a time)
+  virtual int getPlannedBlockCount() const { return -1; }
+
+  // Create a strategy
+  static std::unique_ptr<DefragStrategy> create(DefragStrategyType type);
+
+  // Get whether a strategy leaves all data packed at the beginning (no free space between files to consolidate)
+  static bool compactsFreeSpace(DefragStrategyType type);
+};
+
+// Base class of strategies moving one fragmented file at a time
+// (files in disk order, each to the first free run that fits, unless overridden)
+class FileByFileStrategy : public DefragStrategy {
+protected:
+  // Choose the next file to move (fills fileID and fileBlocks; returns false if none is left)
+  virtual bool selectFile(GridManager& gridManager, FileManager& fileManager, PlannedMove& move);
+
+  // Choose the destination of the file (fills targetPositions; returns false if there is no room)
+  virtual bool findTarget(GridManager& gridManager, FileManager& fileManager, PlannedMove& move);
+
+public:
+  // Plan the next move and apply its result to the grid
+  bool planNextMove(GridManager& gridManager, FileManager& fileManager, PlannedMove& move) override;
+};
+
+// First-fit strategy class (the original behavior)
+class FirstFitStrategy : public FileByFileStrategy {
+public:
+  // Get the name of the strategy
+  const char* getName() const override;
+};
+
+// Best-fit strategy class
+class BestFitStrategy : public FileByFileStrategy {
+protected:
+  // Choose the smallest free run that fits the file (earliest on ties)
+  bool findTarget(GridManager& gridManager, FileManager& fileManager, PlannedMove& move) override;
+
+public:
+  // Get the name of the strategy
+  const char* getName() const override;
+};
+
+// Largest-file-first strategy class
+class LargestFileFirstStrategy : public FileByFileStrategy {
+protected:
+  // Choose the file with the most blocks (earliest on ties)
+  bool selectFile(GridManager& gridManager, FileManager& fileManager, PlannedMove& move) override;
+
+public:
+  // Get the name of the strategy
+  const char* getName() const override;
+};
+
+// Most-fragmented-first strategy class
+class MostFragmentedFirstStrategy : public FileByFileStrategy {
+protected:
+  // Choose the file split into the most fragments (earliest on ties)
+  bool selectFile(GridManager& gridManager, FileManager& fileManager, PlannedMove& move) override;
+
+public:
+  // Get the name of the strategy
+  const char* getName() const override;
+};
+
+// Compaction strategy class (the whole drive is planned when it begins)
+class CompactionStrategy : public DefragStrategy {
+private:
+  CompactionPlanner::Layout layout;
+  std::vector<PlannedMove> plan;  // Moves planned by begin
+  size_t nextMove;  // Index of the next move to hand out
+  int plannedMoveCount;
+  int plannedBlockCount;
+
+public:
+  // Constructor
+  CompactionStrategy(CompactionPlanner::Layout layout);
+
+  // Get the name of the strategy
+  const char* getName() const override;
+
+  // Plan all moves (the grid ends up in the compacted layout)
+  void begin(GridManager& gridManager, FileManager& fileManager) override;
+
+  // Hand out the next planned move
+  bool planNextMove(GridManager& gridManager, FileManager& fileManager, PlannedMove& move) override;
+
+  // Get the number of moves planned by begin
+  int getPlannedMoveCount() const override;
+
+  // Get the number of blocks moved by the moves planned by begin
+  int getPlannedBlockCount() const override;
+};
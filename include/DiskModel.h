@@ -0,0 +1,117 @@
+/**
+ * @file DiskModel.h
+ * @brief Timing models of the simulated drive
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file contains the DiskModel interface and its implementations, which
+ * charge every block read and write with the time it would take on a real
+ * drive. The time of the drive only advances while it services requests, so
+ * the elapsed time is the time the drive has been busy. The spinning disk
+ * model keeps the position of the head and of the platter: a request pays
+ * the seek to its cylinder, waits for its block to come under the head and
+ * then transfers it, so reading the next block of a track costs only the
+ * transfer. The solid-state model pays a fixed latency for every request
+ * that does not continue the previous one.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include "Config.h"
+#include "Enums.h"
+
+// Disk timing model interface
+class DiskModel {
+private:
+  uint64_t elapsedTime;  // Time spent servicing requests (in microseconds)
+  uint64_t transferredBytes;  // Bytes read and written
+  int cellCount;  // Clusters of the drive
+  uint64_t busyUntil;  // Time the last request completes (on the clock of the caller, in microseconds)
+
+protected:
+  // Get the time a block read or write starting at startTime takes from the current state, and update the state
+  virtual uint32_t serviceRequest(int cell, bool isWrite, uint64_t startTime) = 0;
+
+  // Get the number of clusters of the drive
+  int getCellCount() const;
+
+public:
+  // Constructor (a drive of cellCount clusters)
+  DiskModel(int cellCount);
+
+  // Destructor
+  virtual ~DiskModel() {}
+
+  // Get the name of the model
+  virtual const char* getName() const = 0;
+
+  // Reset for a drive of cellCount clusters (the drive is idle and the head at the first cylinder)
+  virtual void reset(int cellCount);
+
+  // Charge a block read or write issued at issueTime (returns its duration in microseconds)
+  // The request starts once the drive has completed the previous one, so requests issued together run back to back
+  uint32_t access(int cell, bool isWrite, uint64_t issueTime = 0);
+
+  // Get the time spent servicing requests (in microseconds)
+  uint64_t getElapsedTime() const;
+
+  // Get the bytes read and written
+  uint64_t getTransferredBytes() const;
+
+  // Get the average throughput so far (in bytes per second, 0 before the first request)
+  uint64_t getThroughput() const;
+
+  // Estimate the time to copy blocks at the throughput so far (in microseconds, 0 if unknown)
+  uint64_t estimateCopyTime(int blockCount) const;
+
+  // Create a model of a drive of cellCount clusters
+  static std::unique_ptr<DiskModel> create(DiskModelType type, int cellCount);
+};
+
+// Spinning disk timing model class
+class HddModel : public DiskModel {
+private:
+  int headCylinder;  // Cylinder under the head
+
+  // Get the seek time across a number of cylinders (in microseconds)
+  uint32_t getSeekTime(int distance, int cylinderCount) const;
+
+protected:
+  // Get the time a block read or write takes: seek (and settling before a write), rotational latency and transfer
+  // (the platter turns with the clock of the caller, so idle time between requests moves it too)
+  uint32_t serviceRequest(int cell, bool isWrite, uint64_t startTime) override;
+
+public:
+  // Constructor
+  HddModel(int cellCount);
+
+  // Get the name of the model
+  const char* getName() const override;
+
+  // Reset
+  void reset(int cellCount) override;
+};
+
+// Solid-state drive timing model class
+class SsdModel : public DiskModel {
+private:
+  int lastCell;  // Cell of the last request (-1: none)
+  bool lastWasWrite;  // Whether the last request was a write
+
+protected:
+  // Get the time a block read or write takes: access latency (unless it continues the last request) and transfer
+  uint32_t serviceRequest(int cell, bool isWrite, uint64_t startTime) override;
+
+public:
+  // Constructor
+  SsdModel(int cellCount);
+
+  // Get the name of the model
+  const char* getName() const override;
+
+  // Reset
+  void reset(int cellCount) override;
+};
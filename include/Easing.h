@@ -0,0 +1,24 @@
+/**
+ * @file Easing.h
+ * @brief Integer easing curves for block movements
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the Easing class which looks up the progress of a block
+ * movement from a precomputed Q16.16 table, so a moving block only needs an
+ * index and a multiply per tick instead of floating-point easing.
+ */
+
+#pragma once
+
+#include "Config.h"
+#include "FixedPoint.h"
+
+// Easing curve class
+class Easing {
+public:
+  // Get the progress (0 to ONE) of an ease-out movement after the given number of ticks
+  // The curve covers MOVE_SPEED of the remaining distance per tick and reaches ONE at EASING_TICKS
+  static fixed_t easeOut(int tick);
+};
@@ -16,6 +16,7 @@ enum class AnimationState {
   READING_DRIVE_INFO_PHASE1,  // Reading drive information (Phase 1)
   READING_DRIVE_INFO_PHASE2,  // Reading drive information (Phase 2: Identifying fixed data)
   DEFRAGMENTING,              // Defragmenting
+  CONSOLIDATING,              // Consolidating free space (sliding files towards the beginning)
   COMPLETED,                  // Completed
   TOUCHED                     // When screen is touched
 };
@@ -43,3 +44,27 @@ enum class BlockState {
   WRITING,                          // Data that's currently being written
   BAD                               // Bad area
 };
+
+// Defrag strategies (how the next file and its destination are chosen)
+enum class DefragStrategyType {
+  FIRST_FIT,              // Files in disk order, each to the first free run that fits
+  BEST_FIT,               // Files in disk order, each to the smallest free run that fits
+  LARGEST_FILE_FIRST,     // Largest file first, to the first free run that fits
+  MOST_FRAGMENTED_FIRST,  // File with the most fragments first, to the first free run that fits
+  SLIDING_COMPACTION,     // All data slid to the beginning of the drive, keeping its order
+  WHOLE_DISK_COMPACTION,  // All data packed to the beginning of the drive with the fewest moves
+  HOT_COLD_COMPACTION     // All data packed to the beginning of the drive, hottest files first
+};
+
+// I/O scheduling policies (order in which queued block reads and writes are serviced)
+enum class IoPolicy {
+  FIFO,      // In the order the requests were queued
+  ELEVATOR,  // Sweep in one direction, then back (SCAN/LOOK)
+  NCQ        // Shortest seek from the current head position first (native command queuing)
+};
+
+// Disk timing models (how long the block reads and writes take on the simulated drive)
+enum class DiskModelType {
+  HDD,  // Spinning disk: seek, rotational latency and media transfer
+  SSD   // Solid-state drive: fixed access latency and transfer
+};
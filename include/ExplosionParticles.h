@@ -0,0 +1,57 @@
+/**
+ * @file ExplosionParticles.h
+ * @brief Particle system for the touch explosion animation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the ExplosionParticles class which animates the debris
+ * of exploded blocks. Positions and velocities are kept in packed arrays
+ * (structure of arrays) of Q16.16 fixed-point numbers so the integrate step
+ * is a set of simple integer loops, and particles that can no longer return
+ * to the screen are culled.
+ */
+
+#pragma once
+
+#include <vector>
+#include "Config.h"
+#include "FixedPoint.h"
+#include "RenderTarget.h"
+
+// Explosion particle system class
+class ExplosionParticles {
+private:
+  std::vector<fixed_t> posX, posY;  // Positions (in grid units)
+  std::vector<fixed_t> prevPosX, prevPosY;  // Positions at the previous tick (for interpolation)
+  std::vector<fixed_t> velX, velY;  // Velocities (in grid units per tick)
+
+  // Calculate the velocity pushing a block at the given screen position away from the touch point
+  static void calculateVelocity(fixed_t screenX, fixed_t screenY, int touchX, int touchY,
+                                fixed_t& velocityX, fixed_t& velocityY);
+
+  // Remove particles that have left the screen for good (keeps drawing order)
+  void cull();
+
+public:
+  // Remove all particles
+  void clear();
+
+  // Add the debris of the block at grid cell (cellX, cellY), currently drawn at (x, y)
+  void spawn(int cellX, int cellY, fixed_t x, fixed_t y, int touchX, int touchY);
+
+  // Push all particles away from a new touch point
+  void kick(int touchX, int touchY);
+
+  // Advance all particles by one tick
+  void update();
+
+  // Get whether all particles have left the screen
+  bool isEmpty() const;
+
+  // Get the number of live particles
+  int getCount() const;
+
+  // Draw all particles (alpha: position between the previous and the current tick)
+  void draw(RenderTarget& target, float alpha) const;
+};
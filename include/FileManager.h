@@ -18,6 +18,13 @@
 #include "Enums.h"
 #include "GridManager.h"
 
+// Move of one file decided by the planning step
+struct PlannedMove {
+  int fileID;  // File to move
+  std::vector<std::pair<int, int>> fileBlocks;  // Current block positions of the file
+  std::vector<std::pair<int, int>> targetPositions;  // Destination of each block (empty: no room, optimize in place)
+};
+
 // File management class
 class FileManager {
 private:
@@ -43,20 +50,38 @@ private:
   // Collect blocks belonging to a file
   void collectFileBlocks(int fileID, std::vector<std::pair<int, int>> &fileBlocks);
   
+  // Collect all unoptimized files that are not moving (in disk order of their first block, without targets)
+  void collectUnoptimizedFiles(std::vector<PlannedMove> &files);
+  
   // Find target positions for a file
   bool findTargetPositionsForFile(const std::vector<std::pair<int, int>> &fileBlocks,
                                     std::vector<std::pair<int, int>> &targetPositions);
   
-  // Move file to target
+  // Move file to target (block movements are staggered from startTime, in microseconds)
   void moveFileToTarget(const std::vector<std::pair<int, int>> &fileBlocks,
                           const std::vector<std::pair<int, int>> &targetPositions,
-                          int fileID);
+                          int fileID, uint64_t startTime);
   
   // Update file movement
   void updateFileMovement();
   
-  // Move next file
-  void moveNextFile();
+  // Move next file (now: simulated time in microseconds)
+  void moveNextFile(uint64_t now);
+  
+  // Decide the next file move without changing the grid (returns false if no file is left)
+  bool planNextMove(PlannedMove &move);
+  
+  // Start a planned move (block movements are staggered from startTime, in microseconds)
+  void applyPlannedMove(const PlannedMove &move, uint64_t startTime);
+  
+  // Change the grid to the state after a planned move has finished (no animation)
+  void completePlannedMove(const PlannedMove &move);
+  
+  // Count the blocks of a started move that have not reached their targets yet
+  int countBlocksInFlight(const PlannedMove &move) const;
+  
+  // Get whether all blocks of a started move have reached their targets
+  bool isMoveFinished(const PlannedMove &move) const;
   
   // Get whether moving
   bool isMoving() const;
@@ -66,4 +91,8 @@ private:
   
   // Get next file ID
   int getNextFileID() const;
+  
+  // Get the access heat of a file (accesses per day, 1 to Config::Placement::MAX_ACCESS_HEAT)
+  // Derived from the file ID, so every layout gets the same skewed mix of hot and cold files
+  static int getAccessHeat(int fileID);
 };
@@ -0,0 +1,79 @@
+/**
+ * @file FixedPoint.h
+ * @brief Q16.16 fixed-point arithmetic for the animation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file contains the fixed_t type and the FixedPoint helpers used by the
+ * block movement and the explosion physics. All animation state is integer,
+ * so a seeded run produces bit-identical positions on every board and on the
+ * native build; floats only appear when a position is converted for drawing.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// Q16.16 fixed-point number (16 integer bits, 16 fraction bits)
+typedef int32_t fixed_t;
+
+namespace FixedPoint {
+  // Number of fraction bits
+  constexpr int FRACTION_BITS = 16;
+
+  // The value 1.0
+  constexpr fixed_t ONE = 1 << FRACTION_BITS;
+
+  // Convert an integer
+  constexpr fixed_t fromInt(int value) {
+    return value * ONE;
+  }
+
+  // Convert a float (meant for compile-time constants, rounds to nearest)
+  constexpr fixed_t fromFloat(float value) {
+    return static_cast<fixed_t>(value * ONE + (value < 0.0f ? -0.5f : 0.5f));
+  }
+
+  // Convert to a float (for drawing only)
+  inline float toFloat(fixed_t value) {
+    return value / static_cast<float>(ONE);
+  }
+
+  // Multiply two values
+  inline fixed_t multiply(fixed_t a, fixed_t b) {
+    return static_cast<fixed_t>((static_cast<int64_t>(a) * b) >> FRACTION_BITS);
+  }
+
+  // Divide two values (b must not be zero)
+  inline fixed_t divide(fixed_t a, fixed_t b) {
+    return static_cast<fixed_t>(static_cast<int64_t>(a) * ONE / b);
+  }
+
+  // Get the absolute value
+  inline fixed_t absolute(fixed_t value) {
+    return value < 0 ? -value : value;
+  }
+
+  // Get the length of the vector (dx, dy) (integer square root, rounds down)
+  inline fixed_t length(fixed_t dx, fixed_t dy) {
+    // The squared length has 32 fraction bits, so its root has 16
+    uint64_t squared = static_cast<uint64_t>(static_cast<int64_t>(dx) * dx) +
+                       static_cast<uint64_t>(static_cast<int64_t>(dy) * dy);
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > squared) {
+      bit >>= 2;
+    }
+    while (bit != 0) {
+      if (squared >= root + bit) {
+        squared -= root + bit;
+        root = (root >> 1) + bit;
+      } else {
+        root >>= 1;
+      }
+      bit >>= 2;
+    }
+    return static_cast<fixed_t>(root);
+  }
+}
@@ -0,0 +1,112 @@
+/**
+ * @file FragmentationMetrics.h
+ * @brief Incremental fragmentation analysis for disk defragmentation simulation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file contains the FragmentationMetrics class which keeps the
+ * fragmentation of a grid up to date as its blocks change, without
+ * rescanning it: the fragments of each file, the fragmented files, the
+ * average fragment size, and the extents of free space. The grid reports
+ * every block change (see GridManager::setBlockState); a change only looks
+ * at the two neighbouring cells in disk order and at the free extent around
+ * the cell, so it costs the same on any size of drive.
+ *
+ * Blocks being read still hold the data of their file, blocks being written
+ * do not yet, and neither is free. Invisible blocks count as what they hide,
+ * so revealing the drive does not change the metrics. Fixed and bad blocks
+ * belong to no file and end free extents.
+ */
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <vector>
+#include "Config.h"
+#include "Enums.h"
+
+// Fragmentation metrics of a grid at one moment
+struct FragmentationSummary {
+  int fileCount;  // Files with data on the drive
+  int fragmentedFileCount;  // Files split into more than one fragment
+  int fragmentCount;  // Fragments (runs of consecutive blocks of one file) of all files
+  int fileBlockCount;  // Blocks holding file data
+  int freeBlockCount;  // Free blocks
+  int freeExtentCount;  // Runs of consecutive free blocks
+  int largestFreeExtent;  // Blocks in the longest run of free blocks
+
+  // Constructor (empty drive)
+  FragmentationSummary();
+
+  // Get the average number of fragments per file
+  float getFragmentsPerFile() const;
+
+  // Get the share of files split into more than one fragment (in percent)
+  int getFragmentedFilePercentage() const;
+
+  // Get the average fragment size (in blocks)
+  float getAverageFragmentSize() const;
+
+  // Get the share of free blocks outside the largest free extent (in percent)
+  int getFreeSpaceFragmentation() const;
+
+  // Get whether two summaries hold the same metrics
+  bool operator==(const FragmentationSummary& other) const;
+  bool operator!=(const FragmentationSummary& other) const;
+};
+
+// Incremental fragmentation metrics class
+class FragmentationMetrics {
+private:
+  // Blocks and fragments of one file
+  struct FileStats {
+    int blockCount;
+    int fragmentCount;
+  };
+
+  std::vector<int> cellFiles;  // File whose data each cell holds (-1: none)
+  std::vector<bool> freeCells;  // Whether each cell is free
+  std::map<int, FileStats> files;  // Files with data on the drive
+  std::map<int, int> freeExtents;  // Length of each free extent, by its first cell
+  std::multiset<int> freeExtentLengths;  // Lengths of all free extents (the longest is last)
+  FragmentationSummary summary;
+
+  // Add a cell to the data of a file (joining the fragments on either side)
+  void addFileBlock(int cell, int fileID);
+
+  // Remove a cell from the data of its file (splitting its fragment)
+  void removeFileBlock(int cell);
+
+  // Add a free cell (merging the free extents on either side)
+  void addFreeCell(int cell);
+
+  // Remove a free cell (splitting its free extent)
+  void removeFreeCell(int cell);
+
+  // Record a free extent
+  void insertFreeExtent(int firstCell, int length);
+
+  // Forget a free extent
+  void eraseFreeExtent(std::map<int, int>::iterator extent);
+
+public:
+  // Constructor (no cells)
+  FragmentationMetrics();
+
+  // Reset to a drive of cellCount cells that are neither free nor data (fill it with update)
+  void reset(int cellCount);
+
+  // Apply the change of a cell to a block state (fileID: file of the block)
+  void update(int cell, BlockState state, int fileID);
+
+  // Get the current metrics
+  const FragmentationSummary& getSummary() const;
+
+  // Get whether a block state holds file data
+  static bool isFileState(BlockState state);
+
+  // Get whether a block state is free space
+  static bool isFreeState(BlockState state);
+};
@@ -0,0 +1,71 @@
+/**
+ * @file FrameScheduler.h
+ * @brief Frame-budget scheduler for disk defragmentation simulation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the FrameScheduler class which paces the main loop to a
+ * target frame time. It runs as many simulation steps as are due and fit in
+ * the frame budget, skips presenting frames when the simulation falls behind,
+ * and supports a turbo factor multiplying the simulation steps per tick.
+ * The simulation can also run on its own task, publishing snapshots that
+ * the render loop draws independently.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "Config.h"
+#include "SimulationClock.h"
+#include "DefragSimulator.h"
+#include "BackgroundTask.h"
+
+// Frame-budget scheduler class
+class FrameScheduler {
+private:
+  SimulationClock clock;
+  std::atomic<int> turboIndex;  // Index of the selected turbo factor (set by the rendering side)
+  int appliedTurboIndex;  // Turbo factor index the pending steps were counted with
+  uint32_t pendingSteps;  // Simulation steps due but not yet run
+  uint32_t lastDrawTime;  // Duration of the last draw (in microseconds)
+  int skippedFrames;  // Number of consecutive frames not presented
+  uint32_t lastStepCount;  // Simulation steps run in the last frame
+  BackgroundTask simulationTask;  // Task running the simulation stage (split mode)
+  DefragSimulator* taskSimulator;  // Simulator driven by the simulation task
+  
+  // Add the simulation steps that have become due (turbo factor steps per tick)
+  void queueDueSteps();
+  
+  // Run pending steps until the time since frameStart reaches the budget
+  void runPendingSteps(DefragSimulator& simulator, uint64_t frameStart, uint32_t budget);
+  
+  // Simulation task main loop
+  static void simulationTaskMain(void* scheduler);
+  
+public:
+  // Constructor
+  FrameScheduler();
+  
+  // Restart pacing from the current time
+  void reset();
+  
+  // Run one frame: due simulation steps within the budget, then draw unless behind
+  void runFrame(DefragSimulator& simulator);
+  
+  // Run one simulation frame: due steps within the budget, then publish a snapshot (split mode)
+  void runSimulationFrame(DefragSimulator& simulator);
+  
+  // Run simulation frames on a task of their own (the caller then only draws snapshots)
+  bool startSimulationTask(DefragSimulator& simulator);
+  
+  // Select the next turbo factor (wraps around, may be called from the rendering side)
+  void cycleTurboFactor();
+  
+  // Get the number of simulation steps per tick
+  int getTurboFactor() const;
+  
+  // Get the number of simulation steps run in the last frame
+  uint32_t getLastStepCount() const;
+};
@@ -0,0 +1,52 @@
+/**
+ * @file FreeSpaceClaims.h
+ * @brief Ownership of free space shared by defrag heads
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file contains the FreeSpaceClaims class which records which head
+ * owns each cell while several heads plan moves at the same time. Free cells
+ * start unclaimed; a head takes a run of them with a compare-and-swap on
+ * every cell and gives the run back if another head got any cell first, so
+ * two heads never own the same free run. Cells freed by a head's own moves
+ * stay with that head, which only reuses them after those moves are done.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "GridManager.h"
+
+// Free space ownership class (lock-free, shared by all heads)
+class FreeSpaceClaims {
+public:
+  // Owner of a free cell no head has claimed yet
+  static constexpr int UNCLAIMED = -1;
+
+  // Owner of a cell holding data or fixed blocks (never claimed)
+  static constexpr int DATA = -2;
+
+private:
+  std::unique_ptr<std::atomic<int>[]> owners;  // Owner of each cell (head index, UNCLAIMED or DATA)
+  int cellCount;
+
+public:
+  // Constructor
+  FreeSpaceClaims();
+
+  // Start over from a grid (free cells unclaimed; only while no head is planning)
+  void reset(const GridManager& gridManager);
+
+  // Get the owner of a cell
+  int getOwner(int cell) const;
+
+  // Claim count cells from firstCell for a head (cells it owns already are kept)
+  // Returns false, claiming nothing, if another head owns any of them
+  bool claim(int head, int firstCell, int count);
+
+  // Give a cell a head has just freed to that head
+  void assign(int cell, int head);
+};
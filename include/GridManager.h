@@ -7,6 +7,8 @@
  * 
  * This file contains the GridManager class which manages the grid of blocks
  * representing disk sectors in the defragmentation simulation.
+ * Once the file IDs are assigned, block states and file IDs change through
+ * setBlockState, which keeps the fragmentation metrics of the grid current.
  */
 
 #pragma once
@@ -17,12 +19,16 @@
 #include "Colors.h"
 #include "Enums.h"
 #include "Block.h"
+#include "FragmentationMetrics.h"
 
 // Grid management class
 class GridManager {
 private:
   std::vector<std::vector<Block>> grid;
   std::mt19937 rng;
+  static bool useFixedSeed;  // Whether to seed with fixedSeed instead of a random seed
+  static uint32_t fixedSeed;  // Seed for reproducible runs
+  FragmentationMetrics fragmentationMetrics;  // Fragmentation of the grid, updated on every block change
   
   // Initialize random number generator
   void initializeRNG();
@@ -43,6 +49,18 @@ public:
   // Set initial block state
   void setInitialBlockState(int x, int y, int randomValue, BlockState primaryState);
   
+  // Change the state of a block (keeping the fragmentation metrics current)
+  void setBlockState(int x, int y, BlockState state);
+  
+  // Change the state and file of a block (keeping the fragmentation metrics current)
+  void setBlockState(int x, int y, BlockState state, int fileID);
+  
+  // Recompute the fragmentation metrics from all blocks (after states or file IDs were set directly)
+  void rebuildFragmentationMetrics();
+  
+  // Get the fragmentation metrics
+  const FragmentationMetrics& getFragmentationMetrics() const;
+  
   // Access to grid
   Block& getBlock(int x, int y);
   const Block& getBlock(int x, int y) const;
@@ -57,4 +75,7 @@ public:
   
   // Access to random number generator
   std::mt19937& getRNG();
+  
+  // Use a fixed random seed for all grids created afterwards (reproducible runs)
+  static void setFixedSeed(uint32_t seed);
 };
@@ -0,0 +1,57 @@
+/**
+ * @file InputManager.h
+ * @brief Input sampling for disk defragmentation simulation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the InputManager class which samples the touch panel
+ * (the mouse in the native SDL build) and the buttons. M5.update() drives
+ * the internal I2C bus that touch and the power chip share on Core2, so it
+ * must stay on one thread: sampling happens on loop() between frames and
+ * only timestamps and queues the events. Touches and button B clicks are posted to the simulator's
+ * lock-free queue and handled on its next tick, button A clicks to a queue
+ * read by loop().
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "Config.h"
+#include "SpscQueue.h"
+
+class DefragSimulator;
+
+// Input event types
+enum class InputEventType {
+  TOUCH_PRESSED,     // The screen was touched (x, y: screen coordinates)
+  BUTTON_A_CLICKED,  // Button A was clicked
+  BUTTON_B_CLICKED   // Button B was clicked (turns the free-space consolidation on or off)
+};
+
+// Timestamped input event
+struct InputEvent {
+  InputEventType type;
+  int x, y;  // Screen coordinates (touch only)
+  uint64_t timestamp;  // Time the input was sampled (in microseconds, see micros64)
+};
+
+// Input management class
+class InputManager {
+private:
+  DefragSimulator* simulator;  // Receives touch events
+  SpscQueue<InputEvent, Config::Input::QUEUE_SIZE> buttonEvents;  // Button events for loop()
+
+public:
+  // Constructor
+  InputManager();
+
+  // Set the simulator that receives touches and button B clicks
+  void begin(DefragSimulator& touchTarget);
+
+  // Sample touch and buttons once (calls M5.update; call it from loop() only)
+  void sample();
+
+  // Take the next button event (returns false if there is none)
+  bool pollButtonEvent(InputEvent& event);
+};
@@ -0,0 +1,88 @@
+/**
+ * @file IoScheduler.h
+ * @brief I/O request queue and scheduling for disk defragmentation simulation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the IoScheduler class which sits between the planner
+ * and the animation. A move is queued as the requests of a block-by-block
+ * copy: the read of each block, then its write to the target. The policy
+ * picks the next request among the first QUEUE_DEPTH queued ones (a write
+ * only once its block has been read), and the head travels to it. The
+ * blocks of the move then start moving in the order their reads were
+ * serviced, and the distance the head has travelled (in clusters) and the
+ * number of I/O operations are kept for comparing policies and queue depths.
+ * A batch copied through a staging buffer (see CopyEngine) is issued as one
+ * sweep of reads in disk order, then one sweep of writes in disk order.
+ * Every serviced request is charged to the timing model of the drive (see
+ * DiskModel), which gives the time the copies would take on a real disk.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Config.h"
+#include "Enums.h"
+#include "FileManager.h"
+#include "DiskModel.h"
+
+// I/O scheduler class (one per disk head)
+class IoScheduler {
+private:
+  // Queued block read or write
+  struct Request {
+    int cell;  // Cluster accessed (linear index in disk order)
+    int block;  // Index of the block in the move
+    bool isWrite;  // Whether the request writes the block to its target
+  };
+
+  IoPolicy policy;
+  int queueDepth;
+  int columnCount;  // Clusters per grid row
+  int headCell;  // Cluster under the head
+  int direction;  // Sweep direction of the elevator (1: towards the end, -1: towards the beginning)
+  uint64_t headTravel;  // Distance travelled by the head (in clusters)
+  uint32_t requestCount;  // Requests serviced
+  uint32_t operationCount;  // I/O operations (runs of requests of one kind to consecutive clusters)
+  bool lastWasWrite;  // Whether the last request serviced was a write
+  std::vector<bool> readBlocks;  // Whether each block of the move being scheduled has been read
+  std::unique_ptr<DiskModel> diskModel;  // Time the serviced requests take on the drive
+
+  // Choose the next request among the first window queued requests
+  int chooseRequest(const std::vector<Request>& queue, int window);
+
+  // Service queued requests issued at issueTime, choosing among the first depth of them, until the queue is empty
+  // (records the blocks in the order they were read)
+  void serviceRequests(std::vector<Request>& queue, int depth, uint64_t issueTime, std::vector<int>& readOrder);
+
+public:
+  // Constructor
+  IoScheduler(IoPolicy policy = Config::Io::POLICY, int queueDepth = Config::Io::QUEUE_DEPTH,
+              DiskModelType diskModelType = Config::Disk::MODEL);
+
+  // Reset for a grid (head at the beginning of the disk, no travel, drive idle; call before the first move)
+  void reset(int columnCount, int rowCount);
+
+  // Service the reads and writes of a move, reordering its blocks into the order their reads were serviced
+  // (staged: the blocks are copied through a staging buffer, all reads before the writes;
+  //  issueTime: simulation time the requests are queued at, in microseconds)
+  void schedule(PlannedMove& move, bool staged = false, uint64_t issueTime = 0);
+
+  // Get the distance travelled by the head (in clusters)
+  uint64_t getHeadTravel() const;
+
+  // Get the number of requests serviced
+  uint32_t getRequestCount() const;
+
+  // Get the number of I/O operations (runs of requests of one kind to consecutive clusters)
+  uint32_t getOperationCount() const;
+
+  // Get the timing model of the drive
+  const DiskModel& getDiskModel() const;
+
+  // Get the name of a policy
+  static const char* getPolicyName(IoPolicy policy);
+};
@@ -0,0 +1,71 @@
+/**
+ * @file MovePlanner.h
+ * @brief Background planning of file moves for disk defragmentation simulation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the MovePlanner class which searches for the next file
+ * moves on a background task while the current move is animating. It plans
+ * on its own copy of the grid and applies each planned move to that copy at
+ * once, so the copy always shows the grid as it will be when the move is
+ * started. The defrag loop then only takes ready moves from a queue.
+ * The moves come from the configured DefragStrategy; strategies that plan
+ * the whole drive up front publish the size of the plan before the first
+ * move is handed over. Such a plan takes a while, so the caller checks
+ * hasBegun and keeps running until it is ready instead of waiting in
+ * takeNextMove.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include "Config.h"
+#include "GridManager.h"
+#include "FileManager.h"
+#include "DefragStrategy.h"
+#include "SpscQueue.h"
+#include "BackgroundTask.h"
+
+// Move planner class
+class MovePlanner {
+private:
+  GridManager planningGrid;  // Grid as it will be after all planned moves (planner task only)
+  FileManager planningFiles;  // File searches on the planning grid (planner task only)
+  std::unique_ptr<DefragStrategy> strategy;  // Strategy choosing the moves (planner task only)
+  SpscQueue<PlannedMove, Config::Planner::QUEUE_SIZE> readyMoves;  // Planned moves not yet taken
+  std::atomic<bool> exhausted;  // Whether all moves have been planned
+  std::atomic<bool> begun;  // Whether the strategy has begun (any plan up front is done)
+  std::atomic<int> plannedMoveCount;  // Number of moves planned up front (-1: not planned yet)
+  std::atomic<int> plannedBlockCount;  // Number of blocks moved by the moves planned up front (-1: not planned yet)
+  BackgroundTask task;  // Task running the planner
+
+  // Hand over a move, waiting while the queue is full (returns false if stopped)
+  bool handOver(const PlannedMove& move);
+
+  // Planner task main loop
+  static void taskMain(void* planner);
+
+public:
+  // Constructor
+  MovePlanner();
+
+  // Start planning the moves for a grid (discards the moves of a previous grid)
+  void begin(const GridManager& gridManager);
+
+  // Stop planning (discards planned moves)
+  void stop();
+
+  // Get whether the strategy has begun, so takeNextMove only waits for single moves being planned
+  bool hasBegun() const;
+
+  // Take the next planned move (waits only if it is still being planned; returns false if none is left)
+  bool takeNextMove(PlannedMove& move);
+
+  // Get the number of moves planned up front (-1: not planned yet or planned one at a time)
+  int getPlannedMoveCount() const;
+
+  // Get the number of blocks moved by the moves planned up front (-1: not planned yet or planned one at a time)
+  int getPlannedBlockCount() const;
+};
@@ -0,0 +1,92 @@
+/**
+ * @file MultiHeadPlanner.h
+ * @brief Region-parallel planning of file moves for several defrag heads
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file contains the MultiHeadPlanner class which splits the disk into
+ * regions of rows, each defragmented by its own head. A head moves the
+ * fragmented files that start in its region, one after another and each as a
+ * whole, to the first free run of its region that fits (or of the rest of the
+ * disk if its region is full). Heads claim free runs through FreeSpaceClaims, so any number of
+ * them can plan at the same time: on a worker thread each in the native
+ * build, and all on one planner task on M5Stack. The heads never read the
+ * grid once planning has started, and every head hands its moves to the
+ * defrag loop through its own queue.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "Config.h"
+#include "GridManager.h"
+#include "FileManager.h"
+#include "FreeSpaceClaims.h"
+#include "SpscQueue.h"
+#include "BackgroundTask.h"
+
+// Multi-head move planner class
+class MultiHeadPlanner {
+private:
+  // Head defragmenting one region
+  struct Head {
+    int firstCell;  // First cell of the region
+    int endCell;  // Cell after the last cell of the region
+    std::vector<PlannedMove> files;  // Fragmented files starting in the region, without targets
+    size_t nextFile;  // Index of the next file to plan
+    std::vector<bool> freeCells;  // Free cells the head owns (planner side only)
+    PlannedMove pendingMove;  // Planned move waiting for room in the queue
+    bool hasPendingMove;
+    SpscQueue<PlannedMove, Config::Planner::QUEUE_SIZE> readyMoves;  // Planned moves not yet taken
+    std::atomic<bool> exhausted;  // Whether all moves of the head have been queued
+  };
+
+  // Task planning every workerCount-th head
+  struct Worker {
+    MultiHeadPlanner* planner;
+    int index;  // Index of the first head planned by the worker
+    BackgroundTask task;
+  };
+
+  int headCount;
+  int workerCount;
+  int columnCount;  // Columns of the grid being planned
+  int rowCount;  // Rows of the grid being planned
+  FreeSpaceClaims claims;  // Owner of each cell
+  std::vector<std::unique_ptr<Head>> heads;
+  std::vector<std::unique_ptr<Worker>> workers;  // Destroyed (stopped) before the heads
+
+  // Split the fragmented files of the grid into the regions of the heads
+  void splitRegions(GridManager& gridManager, FileManager& fileManager);
+
+  // Claim the first free run of count cells between firstCell and endCell (returns -1 if there is none)
+  int claimFreeRun(int headIndex, int firstCell, int endCell, int count);
+
+  // Plan the next move of a head (returns false if no file is left)
+  bool planNextMove(int headIndex, PlannedMove& move);
+
+  // Worker task main loop
+  static void taskMain(void* worker);
+
+public:
+  // Constructor
+  MultiHeadPlanner(int headCount = Config::Planner::HEAD_COUNT);
+
+  // Start planning the moves for a grid (discards the moves of a previous grid; the grid is only read here)
+  void begin(GridManager& gridManager, FileManager& fileManager);
+
+  // Stop planning (discards planned moves)
+  void stop();
+
+  // Take the next planned move of a head (waits only if it is still being planned; returns false if none is left)
+  bool takeNextMove(int headIndex, PlannedMove& move);
+
+  // Get the number of heads
+  int getHeadCount() const;
+
+  // Get the head whose region holds a cell
+  int getRegionHead(int x, int y) const;
+};
@@ -18,19 +18,32 @@
 
 #include <Arduino.h>
 #include <esp_random.h>
+#include <esp_timer.h>
 
-// Arduino already provides millis() and delay() functions
+// Arduino already provides millis(), micros() and delay() functions
 // No need to redefine them
 
+// High-resolution monotonic time in microseconds (does not wrap)
+#define micros64() ((uint64_t)esp_timer_get_time())
+
 #define seed() (millis() + esp_random())
 
 #else
 // Native environment (PC/SDL build)
 
 #include <SDL2/SDL.h>
+#include <cstdint>
 #include <random>
 
+// High-resolution monotonic time in microseconds (does not wrap)
+inline uint64_t micros64() {
+  uint64_t counter = SDL_GetPerformanceCounter();
+  uint64_t frequency = SDL_GetPerformanceFrequency();
+  return (counter / frequency) * 1000000ULL + (counter % frequency) * 1000000ULL / frequency;
+}
+
 #define millis() SDL_GetTicks()
+#define micros() ((uint32_t)micros64())
 #define delay(msec) SDL_Delay(msec)
 #define seed() (SDL_GetTicks() + std::random_device{}())
 
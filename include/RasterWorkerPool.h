@@ -0,0 +1,62 @@
+/**
+ * @file RasterWorkerPool.h
+ * @brief Worker thread pool for parallel rasterization (native build only)
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the RasterWorkerPool class which keeps a small set of
+ * worker threads alive and runs indexed jobs (one per canvas tile) on them.
+ * It is only available in the native PC/SDL environment.
+ */
+
+#pragma once
+
+#ifndef ARDUINO
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// Worker thread pool class
+class RasterWorkerPool {
+private:
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable wakeCondition;  // Signaled when a new batch of jobs is posted
+  std::condition_variable doneCondition;  // Signaled when the last job of a batch finishes
+  std::function<void(int)> job;  // Job of the current batch (called with the job index)
+  int jobCount;  // Number of jobs in the current batch
+  int nextJob;  // Index of the next job to be taken
+  int pendingJobs;  // Number of jobs not yet finished
+  bool stopping;  // Whether the workers should exit
+
+  // Take and run jobs until the current batch is exhausted (called with lock held)
+  void runJobs(std::unique_lock<std::mutex>& lock);
+
+  // Worker thread main loop
+  void workerLoop();
+
+public:
+  // Constructor
+  RasterWorkerPool();
+
+  // Destructor
+  ~RasterWorkerPool();
+
+  // Start worker threads (the calling thread also takes jobs)
+  void start(int threadCount);
+
+  // Stop worker threads
+  void stop();
+
+  // Get the number of threads taking jobs, including the calling thread
+  int getThreadCount() const;
+
+  // Run job(0) ... job(count - 1) in parallel and wait until all are done
+  void run(int count, const std::function<void(int)>& batchJob);
+};
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @file RegressionHarness.h
+ * @brief Headless golden-image regression harness (native build only)
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the RegressionHarness class which runs a seeded
+ * simulation without a display, hashes the rendered frame at chosen frame
+ * numbers and compares the hashes against stored golden frames, reporting
+ * the frame time next to each comparison. It can also print the
+ * fragmentation metrics of each checkpoint, checking the incrementally
+ * maintained values against a full rescan of the grid, or hash the
+ * simulated grid instead of the frame, so that the goldens do not depend
+ * on the M5GFX build (see test/check_goldens.sh). In differential mode it
+ * draws each checkpoint snapshot through the reference render setup and
+ * through the checked setups in the same process and compares the pixels,
+ * which needs no golden file.
+ */
+
+#pragma once
+
+#ifndef ARDUINO
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <M5GFX.h>
+#include "RenderTarget.h"
+
+// Settings of a regression run
+struct RegressionOptions {
+  uint32_t randomSeed;  // Random seed of the simulated drive
+  int width, height;  // Screen size (in pixels)
+  std::vector<int> checkpoints;  // Frame numbers to compare
+  int touchFrame;  // Frame number of a simulated touch (-1: none)
+  int touchX, touchY;  // Screen coordinates of the simulated touch
+  std::string goldenPath;  // File holding the golden frame hashes
+  std::string dumpDirectory;  // Directory for PPM dumps of checkpoint frames (empty: no dump)
+  bool record;  // Whether to record new golden frames instead of comparing
+  bool consolidation;  // Whether the free space is consolidated after defragmenting
+  bool metrics;  // Whether to print the fragmentation metrics of each checkpoint and check them against a rescan
+  bool hashGrid;  // Whether to hash the simulated grid instead of the rendered frame
+  bool differential;  // Whether to compare render setups against the reference setup instead of golden frames
+
+  // Constructor (default settings)
+  RegressionOptions();
+};
+
+// Regression harness class
+class RegressionHarness {
+private:
+  RegressionOptions options;
+  std::vector<uint16_t> framePixels;  // RGB565 pixels of the frame assembled from presented canvases
+  std::vector<uint8_t> frameBytes;  // Raw buffers of the presented canvases, in the order they were presented
+  int movingCheckpoints;  // Differential checkpoints with blocks in flight
+  int debrisCheckpoints;  // Differential checkpoints with explosion debris
+  static RegressionHarness* activeHarness;  // Harness receiving presented canvases
+
+  // Receive a finished canvas (band) from the renderer
+  static void onPresent(M5Canvas& canvas, int originX, int originY);
+
+  // Hash the assembled frame (64-bit FNV-1a over the RGB565 pixels)
+  uint64_t hashFrame() const;
+
+  // Hash the simulated grid (64-bit FNV-1a over the state, file ID and animation position of each block)
+  uint64_t hashGridState() const;
+
+  // Draw the last snapshot again through a render setup and copy the frame (returns the draw time in microseconds)
+  uint32_t drawWithSetup(const RenderSetup& setup, float alpha, std::vector<uint16_t>& pixels);
+
+  // Rasterize the last snapshot with one thread and with Config::Render::RASTER_THREADS on the canvases
+  // of a setup (returns false if the canvas bytes differ)
+  bool compareRasterThreads(const RenderSetup& setup, float alpha);
+
+  // Draw the last snapshot through the reference setup and the checked setups (palettized, configured,
+  // and configured with double-buffered bands) and compare the frames (returns false if a frame differs)
+  bool compareRenderSetups(int frame);
+
+  // Write the assembled frame as a PPM image
+  bool dumpFrame(int frame) const;
+
+  // Print the fragmentation metrics of the simulated drive (returns false if they differ from a rescan)
+  bool printMetrics() const;
+
+  // Load golden frame hashes
+  bool loadGoldens(std::map<int, uint64_t>& goldens) const;
+
+  // Save golden frame hashes
+  bool saveGoldens(const std::map<int, uint64_t>& goldens) const;
+
+public:
+  // Constructor
+  RegressionHarness(const RegressionOptions& options);
+
+  // Parse command line arguments into options
+  static bool parseArguments(int argc, char** argv, RegressionOptions& options);
+
+  // Run the simulation and compare or record checkpoint frames (returns the exit code)
+  int run();
+};
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * @file RenderSnapshot.h
+ * @brief Immutable copy of the simulation state needed to draw one frame
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the RenderSnapshot structure which the simulation fills
+ * after its steps and the renderer draws from, so that the two can run on
+ * different cores. Block states are kept in one byte per cell, and only the
+ * blocks in flight carry animation coordinates.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Enums.h"
+#include "GridManager.h"
+#include "FragmentationMetrics.h"
+#include "AnimationManager.h"
+#include "ExplosionParticles.h"
+
+// Animation coordinates of a block in flight (in grid units)
+struct MovingBlockSnapshot {
+  float prevX, prevY;  // Position at the previous tick
+  float x, y;  // Position at the current tick
+};
+
+// Render snapshot structure
+struct RenderSnapshot {
+  // Flag in blockStates marking a block in flight (its coordinates are in movingBlocks)
+  static const uint8_t MOVING_FLAG = 0x80;
+
+  bool valid;  // Whether the snapshot has been filled
+  int columnCount, rowCount;  // Grid size
+  std::vector<uint8_t> blockStates;  // BlockState of each cell, row by row (with MOVING_FLAG)
+  std::vector<MovingBlockSnapshot> movingBlocks;  // Blocks in flight, in the same order as their cells
+  ExplosionParticles particles;  // Explosion debris
+  AnimationState state;  // Animation state
+  int completionPercentage;  // Progress shown in the status area
+  int hitCounter;  // Hit counter
+  int plannedMoveCount;  // Number of moves in the compaction plan (-1: none)
+  int plannedBlockCount;  // Number of blocks moved by the compaction plan (-1: none)
+  int bufferUsedBlocks;  // Blocks in the staging buffers
+  int bufferCapacity;  // Blocks the staging buffers hold (0: no buffer)
+  uint64_t diskElapsedTime;  // Time the drive has spent copying (in microseconds)
+  uint64_t diskThroughput;  // Average throughput of the drive (in bytes per second)
+  uint64_t diskRemainingTime;  // Estimated time the drive needs for the rest (in microseconds, 0: unknown)
+  uint64_t traceSeekDistanceBefore;  // Head travel of the access trace before defragmenting (in clusters, 0: not measured)
+  uint64_t traceSeekDistanceAfter;  // Head travel of the same trace afterwards (in clusters)
+  FragmentationSummary fragmentation;  // Fragmentation of the drive
+  uint64_t publishTime;  // Time the snapshot was published (in microseconds, see micros64)
+  uint64_t inputTimestamp;  // Sampling time of the newest input reflected in the snapshot (0: none)
+  bool interpolate;  // Whether to interpolate from the previous tick while the next snapshot is due
+
+  // Constructor
+  RenderSnapshot();
+
+  // Copy the grid and the explosion debris (buffers are reused between captures)
+  void capture(const GridManager& gridManager, const AnimationManager& animationManager);
+};
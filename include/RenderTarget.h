@@ -0,0 +1,107 @@
+/**
+ * @file RenderTarget.h
+ * @brief Drawing target for disk defragmentation visualization
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the RenderTarget class which wraps the off-screen canvas
+ * and translates UI colors into the canvas color format, so that blocks and
+ * UI elements can be drawn into either a direct RGB565 or a palettized canvas.
+ */
+
+#pragma once
+
+#include <M5GFX.h>
+#include "Config.h"
+#include "Colors.h"
+
+// Callback receiving a finished canvas and the screen coordinates of its top-left corner
+typedef void (*PresentHook)(M5Canvas& canvas, int originX, int originY);
+
+// Canvas setup of the screen
+struct RenderSetup {
+  int colorDepth;  // Color depth of the canvases (in bits, see Config::Render::CANVAS_COLOR_DEPTH)
+  int bandHeight;  // Height of the strip buffer (in pixels, 0: full-screen canvas)
+  bool doubleBuffer;  // Whether a second canvas is drawn while the first one is transferred
+  int rasterThreads;  // Threads rasterizing blocks in horizontal tiles (native build only)
+
+  // Get the configured setup (Config::Render)
+  static RenderSetup configured();
+
+  // Get the reference setup (direct RGB565, one full-screen canvas, serial rasterization)
+  static RenderSetup reference();
+};
+
+// Drawing target class
+class RenderTarget {
+private:
+  M5Canvas* canvases[2];  // Canvases alternated by double buffering
+  M5Canvas* canvas;  // Canvas currently being drawn
+  int originX, originY;  // Screen coordinates of the canvas top-left corner
+  static PresentHook presentHook;  // Receives finished canvases instead of the display
+
+  // Get whether the canvas stores palette indices
+  bool isPalettized() const;
+
+  // Get the palette index of an RGB565 color (see Colors::Palette)
+  static uint8_t toPaletteIndex(uint16_t color);
+
+public:
+  // Constructor
+  RenderTarget(M5Canvas& canvas, M5Canvas& backCanvas);
+  
+  // Constructor (single canvas, e.g. a tile view)
+  RenderTarget(M5Canvas& canvas);
+
+  // Create the canvas sprite with a color depth in bits
+  // (bandHeight tall when it is above 0 and below the height)
+  static bool createCanvas(M5Canvas& canvas, int width, int height,
+                           int colorDepth = Config::Render::CANVAS_COLOR_DEPTH,
+                           int bandHeight = Config::Render::BAND_HEIGHT);
+
+  // Create the canvases of a screen (returns false if not even the first fits in memory)
+  // Without memory for the depth of the setup smaller palettized depths are used,
+  // and without memory for backCanvas only canvas is drawn (single buffering)
+  static bool createCanvases(M5Canvas& canvas, M5Canvas& backCanvas, int width, int height,
+                             const RenderSetup& setup = RenderSetup::configured());
+
+  // Draw into the first canvas again (after the canvases have been created anew)
+  void reset();
+
+  // Set the screen coordinates mapped to the canvas top-left corner
+  void setOrigin(int x, int y);
+
+  // Get canvas height (band height in band rendering mode)
+  int getHeight() const;
+
+  // Get the screen coordinates mapped to the canvas top-left corner
+  int getOriginX() const;
+  int getOriginY() const;
+
+  // Make tileCanvas a view of screen rows [y, y + h) of the current canvas
+  bool createTileCanvas(M5Canvas& tileCanvas, int y, int h) const;
+
+  // Whether a screen-space rectangle intersects the canvas
+  bool isVisible(int x, int y, int w, int h) const;
+
+  // Drawing primitives (screen coordinates, colors are given in RGB565)
+  void fillScreen(uint16_t color);
+  void fillRect(int x, int y, int w, int h, uint16_t color);
+  void drawRect(int x, int y, int w, int h, uint16_t color);
+  void drawLine(int x0, int y0, int x1, int y1, uint16_t color);
+
+  // Text primitives
+  void setTextColor(uint16_t color);
+  void setTextSize(int size);
+  void setCursor(int x, int y);
+  void print(const char* text);
+  void print(int value);
+
+  // Start transferring canvas content to display at the current origin
+  // and switch drawing to the other canvas while the transfer runs
+  void pushSprite();
+
+  // Send finished canvases to a hook instead of the display (headless runs)
+  static void setPresentHook(PresentHook hook);
+};
@@ -0,0 +1,44 @@
+/**
+ * @file SimulationClock.h
+ * @brief Fixed-timestep simulation clock for disk defragmentation simulation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the SimulationClock class which converts elapsed
+ * wall-clock time into fixed simulation ticks, so that animation speed does
+ * not depend on the frame rate, and provides the interpolation factor for
+ * rendering between two ticks.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "Config.h"
+
+// Fixed-timestep simulation clock class
+class SimulationClock {
+private:
+  uint64_t lastTime;  // Wall-clock time of the last advance (in microseconds)
+  uint64_t accumulator;  // Wall-clock time not yet consumed by ticks (in microseconds)
+  uint32_t tickCount;  // Number of ticks consumed since reset
+  
+public:
+  // Constructor
+  SimulationClock();
+  
+  // Restart from the current wall-clock time
+  void reset();
+  
+  // Accumulate the wall-clock time elapsed since the last call
+  void advance();
+  
+  // Consume one tick if one is due (returns false when the simulation has caught up)
+  bool consumeTick();
+  
+  // Get the position between the previous and the current tick (0.0 to 1.0) for rendering
+  float getInterpolationAlpha() const;
+  
+  // Get the number of ticks consumed since reset
+  uint32_t getTickCount() const;
+};
@@ -15,22 +15,30 @@
 #include <M5Unified.h>
 #include <random>
 #include "Config.h"
+#include "AudioScheduler.h"
+#include "SoundSampleCache.h"
 
 // Sound management class
 class SoundManager {
 private:
   std::mt19937& rng;
+  bool enabled;  // Whether sounds are played
+  SoundSampleCache sampleCache;  // Pre-rendered sound effects
+  AudioScheduler audioScheduler;  // Plays the sound events on a background task
   
 public:
   // Constructor
   SoundManager(std::mt19937& rng);
 
-  // Initialization
+  // Initialization (renders the samples and starts the audio task)
   void initialize();
 
-  // Play hard disk seek sound
+  // Play hard disk seek sound (queued, returns immediately)
   void playSeekSound();
 
-  // Play explosion sound
+  // Play explosion sound (queued, returns immediately)
   void playExplosionSound();
+  
+  // Enable or disable sound output (e.g. for headless runs)
+  void setEnabled(bool isEnabled);
 };
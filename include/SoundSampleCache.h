@@ -0,0 +1,44 @@
+/**
+ * @file SoundSampleCache.h
+ * @brief Pre-synthesized PCM samples of the sound effects
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the SoundSampleCache class which renders the seek click
+ * variants and the explosion into small 16-bit PCM buffers once, so that
+ * playing an effect is only a buffer handoff to the speaker. Each effect's
+ * gain is baked into its samples instead of changing the speaker volume.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Config.h"
+
+// PCM sample cache class
+class SoundSampleCache {
+private:
+  std::vector<std::vector<int16_t>> seekClicks;  // Seek click variants (frequency and length vary)
+  std::vector<int16_t> explosion;  // Explosion sound
+
+  // Render a square wave tone with a short fade-out
+  static void synthesizeTone(std::vector<int16_t>& pcm, float frequency, uint32_t duration, float gain);
+
+public:
+  // Render all samples (does nothing if already rendered)
+  void initialize();
+
+  // Get whether the samples have been rendered
+  bool isInitialized() const;
+
+  // Get the number of seek click variants
+  int getSeekClickCount() const;
+
+  // Get a seek click variant
+  const std::vector<int16_t>& getSeekClick(int index) const;
+
+  // Get the explosion sound
+  const std::vector<int16_t>& getExplosion() const;
+};
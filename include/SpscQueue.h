@@ -0,0 +1,62 @@
+/**
+ * @file SpscQueue.h
+ * @brief Lock-free single-producer single-consumer queue
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the SpscQueue class template, a fixed-size ring buffer
+ * that passes items from one producer thread (or task) to one consumer
+ * without locks. Neither side ever blocks: push fails when the queue is full
+ * and pop fails when it is empty.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Lock-free single-producer single-consumer queue class (Capacity must be a power of two)
+template <typename T, size_t Capacity>
+class SpscQueue {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+private:
+  T items[Capacity];
+  std::atomic<size_t> head;  // Number of items popped so far (written by the consumer only)
+  std::atomic<size_t> tail;  // Number of items pushed so far (written by the producer only)
+
+public:
+  // Constructor
+  SpscQueue()
+    : head(0),
+      tail(0) {
+  }
+
+  // Add an item (producer side, returns false if the queue is full)
+  bool push(const T& item) {
+    size_t currentTail = tail.load(std::memory_order_relaxed);
+    if (currentTail - head.load(std::memory_order_acquire) >= Capacity) {
+      return false;
+    }
+    items[currentTail & (Capacity - 1)] = item;
+    tail.store(currentTail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Take the oldest item (consumer side, returns false if the queue is empty)
+  bool pop(T& item) {
+    size_t currentHead = head.load(std::memory_order_relaxed);
+    if (currentHead == tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = items[currentHead & (Capacity - 1)];
+    head.store(currentHead + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Get whether the queue is empty (exact only on the consumer side)
+  bool isEmpty() const {
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+  }
+};
@@ -0,0 +1,148 @@
+/**
+ * @file StrategyBenchmark.h
+ * @brief Native benchmark comparing the defrag strategies (native build only)
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file contains the StrategyBenchmark class which runs every defrag
+ * strategy on the same seeded drive layouts and reports the number of moves,
+ * the blocks moved, the planning CPU time, the time the copies take on the
+ * simulated drive (see DiskModel), the contiguity of the result and how
+ * far the head travels for a synthetic access trace (see AccessTrace)
+ * replayed before and after.
+ * It then plans the same layouts with several numbers of defrag heads and
+ * replays the moves through the block animation, to show how the simulated
+ * defrag time scales with the number of heads, and services the moves of the
+ * configured strategy with each I/O policy to compare the head travel, and
+ * copies them through staging buffers of several sizes to compare the
+ * number of I/O operations.
+ * In validation mode it instead replays the moves of every strategy on each
+ * layout and checks that no move overwrites data, no data is lost, fixed
+ * blocks stay where they are and every moved file ends up in consecutive
+ * cells.
+ */
+
+#pragma once
+
+#ifndef ARDUINO
+
+#include <cstdint>
+#include <vector>
+#include "Enums.h"
+#include "GridManager.h"
+#include "FileManager.h"
+
+// Settings of a benchmark run
+struct BenchmarkOptions {
+  uint32_t firstSeed;  // Random seed of the first layout
+  int layoutCount;  // Number of layouts (consecutive seeds)
+  int width, height;  // Screen size (in pixels) deciding the grid size
+  std::vector<DefragStrategyType> strategies;  // Strategies to compare
+  std::vector<int> headCounts;  // Numbers of heads to compare
+  std::vector<int> queueDepths;  // I/O queue depths to compare
+  std::vector<int> bufferSizes;  // Staging buffer sizes to compare (in blocks, 0: no buffer)
+  bool validate;  // Check the moves of the strategies instead of comparing them
+
+  // Constructor (default settings: all strategies, 1 to 8 heads, queue depths 1 to 32, buffers of 0 to 128 blocks)
+  BenchmarkOptions();
+};
+
+// Results of one strategy, summed over all layouts
+struct BenchmarkResult {
+  long moveCount;  // Moves with a destination
+  long movedBlockCount;  // Blocks moved
+  double planningTime;  // Planning CPU time (in seconds)
+  uint64_t diskTime;  // Time the copies take on the drive, through the configured staging buffer (in microseconds)
+  long fileCount;  // Files fragmented before defragmentation
+  long contiguousFileCount;  // Of those, files contiguous afterwards
+  long dataBlockCount;  // Data blocks on the drive
+  long compactedBlockCount;  // Data blocks before the first free cell afterwards
+  long freeRunCount;  // Runs of free cells afterwards
+  long consolidatedFreeRunCount;  // Runs of free cells after consolidating the free space as well
+  uint64_t traceSeekBefore;  // Head travel of the access trace before defragmenting (in clusters)
+  uint64_t traceSeekAfter;  // Head travel of the same trace afterwards (in clusters)
+
+  // Constructor
+  BenchmarkResult();
+};
+
+// Results of one number of heads, summed over all layouts
+struct HeadScalingResult {
+  long moveCount;  // Moves with a destination
+  long movedBlockCount;  // Blocks moved
+  long crossRegionMoveCount;  // Moves to free space in another head's region
+  long conflictCount;  // Moves whose destination was not free when they started (always 0)
+  long defragTicks;  // Simulated ticks until the last file arrived
+  uint64_t diskTime;  // Time the copies take on the drive, heads in parallel (in microseconds)
+  long fileCount;  // Fragmented files before defragmenting
+  long contiguousFileCount;  // Of those, files in consecutive cells afterwards
+
+  // Constructor
+  HeadScalingResult();
+};
+
+// Results of one staging buffer size, summed over all layouts
+struct CopyResult {
+  long batchCount;  // Batches copied
+  long requestCount;  // Reads and writes of single blocks
+  long operationCount;  // I/O operations (runs of requests of one kind to consecutive clusters)
+  uint64_t headTravel;  // Distance travelled by the head (in clusters)
+  uint64_t diskTime;  // Time the copies take on the drive (in microseconds)
+  uint64_t transferredBytes;  // Bytes read and written
+
+  // Constructor
+  CopyResult();
+};
+
+// Strategy benchmark class
+class StrategyBenchmark {
+private:
+  BenchmarkOptions options;
+
+  // Create a drive layout as it is after reading drive information (unique IDs for optimized blocks)
+  static void createLayout(uint32_t seed, GridManager& gridManager);
+
+  // Run a strategy on a layout and add its results
+  static void runStrategy(DefragStrategyType type, GridManager& gridManager, BenchmarkResult& result);
+
+  // Measure the contiguity of a defragmented layout and add it to the results
+  static void measureLayout(const GridManager& gridManager, const std::vector<int>& fileIDs,
+                            BenchmarkResult& result);
+
+  // Count the files whose blocks occupy consecutive cells (a fixed block between them splits a file)
+  static int countContiguousFiles(const GridManager& gridManager, const std::vector<int>& fileIDs);
+
+  // Plan a layout with a number of heads, replay the moves through the animation and add the results
+  static void runHeads(int headCount, const GridManager& gridManager, HeadScalingResult& result);
+
+  // Replay the moves of a strategy on a layout and print every problem found (returns the number of problems)
+  static int validateStrategy(DefragStrategyType type, uint32_t seed, const GridManager& gridManager, long& moveCount);
+
+  // Validate every strategy on every layout (returns the exit code)
+  int runValidation(const std::vector<GridManager>& layouts);
+
+  // Plan all moves of a strategy on a layout
+  static void collectMoves(DefragStrategyType type, const GridManager& gridManager, std::vector<PlannedMove>& moves);
+
+  // Measure the head travel of servicing moves planned on a layout with an I/O policy and queue depth (in clusters)
+  static uint64_t measureHeadTravel(IoPolicy policy, int queueDepth, const GridManager& gridManager,
+                                    const std::vector<PlannedMove>& moves);
+
+  // Copy moves planned on a layout through a staging buffer with the configured I/O policy and queue depth
+  // and add the results
+  static void runCopy(int bufferSize, const GridManager& gridManager, const std::vector<PlannedMove>& moves,
+                      CopyResult& result);
+
+public:
+  // Constructor
+  StrategyBenchmark(const BenchmarkOptions& options);
+
+  // Parse command line arguments into options
+  static bool parseArguments(int argc, char** argv, BenchmarkOptions& options);
+
+  // Run the benchmark and print the comparison (returns the exit code)
+  int run();
+};
+
+#endif
@@ -0,0 +1,64 @@
+/**
+ * @file TripleBuffer.h
+ * @brief Lock-free triple buffer for handing data from one thread to another
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file contains the TripleBuffer class template. A producer fills the
+ * write buffer and publishes it, a consumer acquires the most recently
+ * published buffer and reads it. The two sides never wait for each other:
+ * the third buffer holds the latest published data in between.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free triple buffer class (one producer, one consumer)
+template <typename T>
+class TripleBuffer {
+private:
+  static const uint8_t INDEX_MASK = 0x03;
+  static const uint8_t FRESH = 0x04;  // Set while the middle buffer holds data not yet acquired
+
+  T buffers[3];
+  std::atomic<uint8_t> middle;  // Index of the buffer between the two sides (with the FRESH flag)
+  uint8_t back;  // Index of the buffer being written (producer only)
+  uint8_t front;  // Index of the buffer being read (consumer only)
+
+public:
+  // Constructor
+  TripleBuffer()
+    : middle(1),
+      back(0),
+      front(2) {
+  }
+
+  // Get the buffer to fill (producer side)
+  T& getWriteBuffer() {
+    return buffers[back];
+  }
+
+  // Publish the filled buffer and take the middle buffer as the next write buffer (producer side)
+  void publish() {
+    uint8_t previous = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+    back = previous & INDEX_MASK;
+  }
+
+  // Switch to the most recently published buffer (consumer side, returns false if nothing new)
+  bool acquire() {
+    if ((middle.load(std::memory_order_acquire) & FRESH) == 0) {
+      return false;
+    }
+    uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+    front = previous & INDEX_MASK;
+    return true;
+  }
+
+  // Get the acquired buffer (consumer side)
+  const T& getReadBuffer() const {
+    return buffers[front];
+  }
+};
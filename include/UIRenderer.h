@@ -12,31 +12,75 @@
 
 #pragma once
 
+#include <vector>
+#include <memory>
 #include <M5GFX.h>
 #include "Config.h"
 #include "Colors.h"
 #include "Enums.h"
 #include "GridManager.h"
+#include "FragmentationMetrics.h"
 #include "AnimationManager.h"
+#include "RenderSnapshot.h"
+#include "RenderTarget.h"
+#include "RasterWorkerPool.h"
 
 // External declaration
 extern M5Canvas canvas;
+extern M5Canvas backCanvas;
 
 // UI rendering class
 class UIRenderer {
 private:
+  // Status kept by the simulation (copied into each snapshot)
   AnimationState state;
   int completionPercentage;
   int screenWidth;  // Member variable to store screen width
   int screenHeight;  // Member variable to store screen height
   int hitCounter; // Hit counter
+  int plannedMoveCount;  // Number of moves in the compaction plan (-1: none)
+  int plannedBlockCount;  // Number of blocks moved by the compaction plan (-1: none)
+  int bufferUsedBlocks;  // Blocks in the staging buffers
+  int bufferCapacity;  // Blocks the staging buffers hold (0: no buffer)
+  uint64_t diskElapsedTime;  // Time the drive has spent copying (in microseconds)
+  uint64_t diskThroughput;  // Average throughput of the drive (in bytes per second)
+  uint64_t diskRemainingTime;  // Estimated time the drive needs for the rest (in microseconds, 0: unknown)
+  uint64_t traceSeekDistanceBefore;  // Head travel of the access trace before defragmenting (in clusters, 0: not measured)
+  uint64_t traceSeekDistanceAfter;  // Head travel of the same trace afterwards (in clusters)
+  FragmentationSummary fragmentation;  // Fragmentation of the drive
+  
+  // Drawing state (used by the rendering side only)
+  int turboFactor;  // Simulation steps per tick (shown when above 1)
+  uint32_t inputLatency;  // Last measured input-to-photon latency (in microseconds, 0: not measured)
+  float interpolationAlpha;  // Position between the previous and the current tick for the frame being drawn
+  const RenderSnapshot* snapshot;  // Snapshot of the frame being drawn
+  RenderTarget target;  // Drawing target wrapping the off-screen canvas
+#ifndef ARDUINO
+  RasterWorkerPool rasterPool;  // Worker threads for parallel block rasterization
+  std::vector<std::unique_ptr<M5Canvas>> tileCanvases;  // Per-tile views of the canvas
+#endif
+  
+  // Draw all blocks and explosion debris into a drawing target
+  void drawBlocksTo(RenderTarget& blockTarget);
+  
+  // Draw blocks (in parallel tiles when worker threads are available)
+  void drawBlocks();
+  
+  // Draw the scene into the current band of the canvas
+  void drawScene();
+  
+  // Start the raster worker threads (native build only, kept while the count stays the same)
+  void startRasterThreads(int threadCount);
   
 public:
   // Constructor
   UIRenderer();
   
-  // Initialization
+  // Initialization (screen size and rendering resources)
   void initialize();
+  
+  // Create the canvases and raster threads of a setup anew (returns false if no canvas fits in memory)
+  bool applyRenderSetup(const RenderSetup& setup);
 
   // Draw UI elements
   void drawUI();
@@ -44,8 +88,11 @@ public:
   // Draw hit counter
   void drawHitCounter();
 
-  // Draw grid and UI elements
-  void draw(GridManager& gridManager, AnimationManager& animationManager);
+  // Draw grid and UI elements from a snapshot (alpha: position between the previous and the current tick)
+  void draw(const RenderSnapshot& frameSnapshot, float alpha);
+  
+  // Copy the status (state, progress, hits) into a snapshot
+  void captureStatus(RenderSnapshot& frameSnapshot) const;
   
   // Set state
   void setState(AnimationState newState);
@@ -64,4 +111,28 @@ public:
   
   // Get hit counter
   int getHitCounter() const;
+  
+  // Reset hit counter
+  void resetHitCounter();
+  
+  // Set the size of the compaction plan (-1: none)
+  void setPlanSummary(int moveCount, int blockCount);
+  
+  // Set the occupancy of the staging buffers (in blocks)
+  void setBufferOccupancy(int usedBlocks, int capacity);
+  
+  // Set the time the copies take on the drive (times in microseconds, throughput in bytes per second)
+  void setDiskStatus(uint64_t elapsedTime, uint64_t throughput, uint64_t remainingTime);
+  
+  // Set the head travel of the access trace before and after defragmenting (in clusters, 0 before: not measured)
+  void setTraceSeekDistances(uint64_t before, uint64_t after);
+  
+  // Set the fragmentation of the drive
+  void setFragmentation(const FragmentationSummary& summary);
+  
+  // Set turbo factor
+  void setTurboFactor(int factor);
+  
+  // Set the measured input-to-photon latency (in microseconds)
+  void setInputLatency(uint32_t latency);
 };
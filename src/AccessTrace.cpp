@@ -0,0 +1,99 @@
+/**
+ * @file AccessTrace.cpp
+ * @brief Implementation of synthetic file access trace
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file implements the AccessTrace class. Files are drawn with a fixed
+ * seed, weighted by their access heat, and each access reads the blocks of
+ * the file through the timing model of the drive.
+ */
+
+#include <memory>
+#include <random>
+#include "AccessTrace.h"
+#include "FileManager.h"
+#include "DiskModel.h"
+
+// Constructor
+TraceReplay::TraceReplay()
+  : seekDistance(0),
+    diskTime(0) {
+}
+
+// Constructor
+AccessTrace::AccessTrace() {
+}
+
+// Collect the cells of the movable data of each file
+void AccessTrace::collectFileCells(const GridManager& gridManager, std::map<int, std::vector<int>>& fileCells) {
+  fileCells.clear();
+  for (int y = 0; y < gridManager.getRowCount(); y++) {
+    for (int x = 0; x < gridManager.getColumnCount(); x++) {
+      const Block& block = gridManager.getBlock(x, y);
+      // Fixed blocks belong to system areas the workload does not read
+      if (block.state == BlockState::UNOPT_BEGIN ||
+          block.state == BlockState::UNOPT_MIDDLE ||
+          block.state == BlockState::UNOPT_END ||
+          block.state == BlockState::OPTIMIZED) {
+        fileCells[block.fileID].push_back(y * gridManager.getColumnCount() + x);
+      }
+    }
+  }
+}
+
+// Draw the trace from the files on the drive
+void AccessTrace::generate(const GridManager& gridManager) {
+  std::map<int, std::vector<int>> fileCells;
+  collectFileCells(gridManager, fileCells);
+
+  fileIDs.clear();
+  if (fileCells.empty()) {
+    return;
+  }
+
+  // Each file is drawn in proportion to its access heat
+  std::vector<int> candidates;
+  std::vector<double> weights;
+  for (const auto &file : fileCells) {
+    candidates.push_back(file.first);
+    weights.push_back(FileManager::getAccessHeat(file.first));
+  }
+  std::mt19937 rng(Config::Placement::TRACE_SEED);
+  std::discrete_distribution<int> fileDist(weights.begin(), weights.end());
+  for (int i = 0; i < Config::Placement::TRACE_LENGTH; i++) {
+    fileIDs.push_back(candidates[fileDist(rng)]);
+  }
+}
+
+// Replay the trace on a layout
+TraceReplay AccessTrace::replay(const GridManager& gridManager) const {
+  std::map<int, std::vector<int>> fileCells;
+  collectFileCells(gridManager, fileCells);
+
+  std::unique_ptr<DiskModel> diskModel =
+      DiskModel::create(Config::Disk::MODEL, gridManager.getColumnCount() * gridManager.getRowCount());
+  TraceReplay result;
+  int headCell = 0;
+  for (int fileID : fileIDs) {
+    std::map<int, std::vector<int>>::const_iterator file = fileCells.find(fileID);
+    if (file == fileCells.end()) {
+      continue;
+    }
+
+    // Every block of the file is read in disk order
+    for (int cell : file->second) {
+      result.seekDistance += (cell > headCell) ? cell - headCell : headCell - cell;
+      headCell = cell;
+      diskModel->access(cell, false);
+    }
+  }
+  result.diskTime = diskModel->getElapsedTime();
+  return result;
+}
+
+// Get whether the trace holds no access
+bool AccessTrace::isEmpty() const {
+  return fileIDs.empty();
+}
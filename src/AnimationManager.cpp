@@ -10,6 +10,7 @@
  */
 
 #include "AnimationManager.h"
+#include <algorithm>
 
 // Constructor
 AnimationManager::AnimationManager(GridManager& gridManager)
@@ -20,7 +21,8 @@ AnimationManager::AnimationManager(GridManager& gridManager)
     driveInfoPhase1ScanCompleted(false),
     driveInfoPhase2ScanX(0),
     driveInfoPhase2ScanY(0),
-    driveInfoPhase2ScanCompleted(false) {
+    driveInfoPhase2ScanCompleted(false),
+    scanBudget(0) {
 }
 
 // Reset
@@ -32,6 +34,31 @@ void AnimationManager::reset() {
   driveInfoPhase2ScanX = 0;
   driveInfoPhase2ScanY = 0;
   driveInfoPhase2ScanCompleted = false;
+  scanBudget = 0;
+  explosionParticles.clear();
+}
+
+// Sweep the clusters one tick of scan budget allows
+bool AnimationManager::scanClusters(int& scanX, int& scanY, void (Block::*updateState)()) {
+  // Add this tick's share of the throughput (the remainder carries over to the next tick)
+  scanBudget += (uint64_t)Config::Animation::SCAN_CLUSTERS_PER_SECOND * Config::Animation::TICK_INTERVAL;
+  int clusterCount = scanBudget / 1000000;
+  scanBudget %= 1000000;
+  
+  // Update blocks in scan order, continuing mid-row where the previous tick stopped
+  for (int i = 0; i < clusterCount && scanY < gridManager.getRowCount(); i++) {
+    (gridManager.getBlock(scanX, scanY).*updateState)();
+    
+    // Move to the next cluster
+    scanX++;
+    if (scanX >= gridManager.getColumnCount()) {
+      scanX = 0;
+      scanY++;
+    }
+  }
+  
+  // Whether all rows have been scanned
+  return scanY >= gridManager.getRowCount();
 }
 
 // Block update process in reading drive info phase 1
@@ -41,18 +68,12 @@ void AnimationManager::updateBlocksInDriveInfoPhase1() {
     return;
   }
   
-  // Update all blocks in the current row
-  for (driveInfoPhase1ScanX = 0; driveInfoPhase1ScanX < gridManager.getColumnCount(); driveInfoPhase1ScanX++) {
-    gridManager.getBlock(driveInfoPhase1ScanX, driveInfoPhase1ScanY).updateStateInDriveInfoPhase1();
-  }
+  driveInfoPhase1ScanCompleted = scanClusters(driveInfoPhase1ScanX, driveInfoPhase1ScanY,
+                                              &Block::updateStateInDriveInfoPhase1);
   
-  // Move to the next row
-  driveInfoPhase1ScanX = 0;
-  driveInfoPhase1ScanY++;
-  
-  // If all rows have been scanned
-  if (driveInfoPhase1ScanY >= gridManager.getRowCount()) {
-    driveInfoPhase1ScanCompleted = true;
+  // Phase 2 starts with a fresh budget
+  if (driveInfoPhase1ScanCompleted) {
+    scanBudget = 0;
   }
 }
 
@@ -63,19 +84,8 @@ void AnimationManager::updateBlocksInDriveInfoPhase2() {
     return;
   }
   
-  // Update all blocks in the current row
-  for (driveInfoPhase2ScanX = 0; driveInfoPhase2ScanX < gridManager.getColumnCount(); driveInfoPhase2ScanX++) {
-    gridManager.getBlock(driveInfoPhase2ScanX, driveInfoPhase2ScanY).updateStateInDriveInfoPhase2();
-  }
-  
-  // Move to the next row
-  driveInfoPhase2ScanX = 0;
-  driveInfoPhase2ScanY++;
-  
-  // If all rows have been scanned
-  if (driveInfoPhase2ScanY >= gridManager.getRowCount()) {
-    driveInfoPhase2ScanCompleted = true;
-  }
+  driveInfoPhase2ScanCompleted = scanClusters(driveInfoPhase2ScanX, driveInfoPhase2ScanY,
+                                              &Block::updateStateInDriveInfoPhase2);
 }
 
 // Collect positions of moving and reading blocks
@@ -99,10 +109,10 @@ void AnimationManager::collectMovingAndReadingBlocks(std::vector<std::pair<int,
 }
 
 // Update all blocks
-void AnimationManager::updateAllBlocks() {
+void AnimationManager::updateAllBlocks(uint64_t now) {
   for (int y = 0; y < gridManager.getRowCount(); y++) {
     for (int x = 0; x < gridManager.getColumnCount(); x++) {
-      gridManager.getBlock(x, y).updateMoving();
+      gridManager.getBlock(x, y).updateMoving(now);
     }
   }
 }
@@ -111,6 +121,7 @@ void AnimationManager::updateAllBlocks() {
 bool AnimationManager::processCompletedBlocks(const std::vector<std::pair<int, int>>& movingBlockPositions, 
                                             const std::vector<std::pair<int, int>>& readingBlockPositions) {
   bool anyBlockCompleted = false;
+  std::vector<int> completedFileIDs;  // Files of the blocks that have completed movement
   
   // Process blocks that have completed movement
   for (auto &pos : movingBlockPositions) {
@@ -121,25 +132,29 @@ bool AnimationManager::processCompletedBlocks(const std::vector<std::pair<int, i
     // Check if movement is complete (when isMoving flag becomes false)
     if (!block.isMoving) {
       anyBlockCompleted = true;
+      completedFileIDs.push_back(block.fileID);
       
       // If the target position and current position are the same (when movement is complete)
       if (x == block.targetX && y == block.targetY) {
         // Set the target block to optimized
-        block.state = BlockState::OPTIMIZED;
+        gridManager.setBlockState(x, y, BlockState::OPTIMIZED);
       }
     }
   }
   
-  // If movement is complete, set the source blocks to free space
+  // If movement is complete, set the source blocks of those files to free space
+  // (files moved by other heads keep theirs until their own blocks arrive)
   if (anyBlockCompleted) {
     for (auto &pos : readingBlockPositions) {
       int x = pos.first;
       int y = pos.second;
       Block& block = gridManager.getBlock(x, y);
+      if (std::find(completedFileIDs.begin(), completedFileIDs.end(), block.fileID) == completedFileIDs.end()) {
+        continue;
+      }
       
       // Set the source block to free space
-      block.state = BlockState::FREE;
-      block.fileID = -1;
+      gridManager.setBlockState(x, y, BlockState::FREE, -1);
     }
   }
   
@@ -147,7 +162,7 @@ bool AnimationManager::processCompletedBlocks(const std::vector<std::pair<int, i
 }
 
 // Block update process in defragmenting
-void AnimationManager::updateBlocksInDefragmenting() {
+void AnimationManager::updateBlocksInDefragmenting(uint64_t now) {
   // Record positions of moving blocks
   std::vector<std::pair<int, int>> movingBlockPositions;
   // Record positions of blocks being read (READING)
@@ -157,12 +172,52 @@ void AnimationManager::updateBlocksInDefragmenting() {
   collectMovingAndReadingBlocks(movingBlockPositions, readingBlockPositions);
   
   // Update all blocks
-  updateAllBlocks();
+  updateAllBlocks(now);
   
   // Process blocks that have completed movement
   processCompletedBlocks(movingBlockPositions, readingBlockPositions);
 }
 
+// Turn all visible blocks into explosion debris (from touch coordinates)
+void AnimationManager::startExplosion(int touchX, int touchY) {
+  // Debris already flying is pushed away from the new touch point
+  explosionParticles.kick(touchX, touchY);
+  
+  for (int y = 0; y < gridManager.getRowCount(); y++) {
+    for (int x = 0; x < gridManager.getColumnCount(); x++) {
+      Block& block = gridManager.getBlock(x, y);
+      // Explode blocks other than invisible or free areas
+      if (!block.canExplode()) {
+        continue;
+      }
+      
+      // Moving blocks explode from where they are drawn
+      fixed_t startX = block.isMoving ? block.animX : FixedPoint::fromInt(x);
+      fixed_t startY = block.isMoving ? block.animY : FixedPoint::fromInt(y);
+      explosionParticles.spawn(x, y, startX, startY, touchX, touchY);
+      
+      // The block itself is gone from the grid
+      gridManager.setBlockState(x, y, BlockState::FREE, -1);
+      block.isMoving = false;
+    }
+  }
+}
+
+// Update explosion animation
+void AnimationManager::updateExplosion() {
+  explosionParticles.update();
+}
+
+// Get whether all explosion debris has left the screen
+bool AnimationManager::isExplosionFinished() const {
+  return explosionParticles.isEmpty();
+}
+
+// Get explosion debris
+const ExplosionParticles& AnimationManager::getExplosionParticles() const {
+  return explosionParticles;
+}
+
 // Update defrag step
 void AnimationManager::incrementDefragStep() {
   defragStep++;
@@ -0,0 +1,97 @@
+/**
+ * @file AudioScheduler.cpp
+ * @brief Implementation of asynchronous sound event scheduler
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the AudioScheduler class which decouples sound output
+ * from the simulation. The simulation posts sound events to a lock-free
+ * queue and a background task plays them on a pool of speaker channels.
+ */
+
+#include <M5Unified.h>
+#include "AudioScheduler.h"
+
+// Constructor
+AudioScheduler::AudioScheduler()
+  : droppedEvents(0),
+    nextVoice(0) {
+}
+
+// Start the audio task
+void AudioScheduler::start() {
+  if (task.isRunning()) {
+    return;
+  }
+  task.start("audio",
+             Config::Sound::Scheduler::TASK_CORE,
+             Config::Sound::Scheduler::TASK_PRIORITY,
+             Config::Sound::Scheduler::TASK_STACK_SIZE,
+             &AudioScheduler::taskMain, this);
+}
+
+// Stop the audio task
+void AudioScheduler::stop() {
+  task.stop();
+}
+
+// Get whether the audio task is running
+bool AudioScheduler::isRunning() const {
+  return task.isRunning();
+}
+
+// Queue a sound event
+bool AudioScheduler::post(const SoundEvent& event) {
+  if (!queue.push(event)) {
+    droppedEvents++;
+    return false;
+  }
+  return true;
+}
+
+// Get the number of events dropped because the queue was full
+uint32_t AudioScheduler::getDroppedEventCount() const {
+  return droppedEvents;
+}
+
+// Audio task main loop
+void AudioScheduler::taskMain(void* scheduler) {
+  AudioScheduler* self = static_cast<AudioScheduler*>(scheduler);
+  
+  while (!self->task.isStopRequested()) {
+    SoundEvent event;
+    if (!self->queue.pop(event)) {
+      // Nothing to play: wait for the simulation to post more events
+      BackgroundTask::sleepFor(Config::Sound::Scheduler::IDLE_INTERVAL);
+      continue;
+    }
+    
+    self->playOnVoice(*event.sample);
+    
+    // Keep the spacing between consecutive sounds (only this task waits)
+    if (event.gapAfter > 0) {
+      BackgroundTask::sleepFor(event.gapAfter);
+    }
+  }
+}
+
+// Play a sample on a free voice, or on the oldest voice if all are busy
+void AudioScheduler::playOnVoice(const std::vector<int16_t>& sample) {
+  const int voiceCount = Config::Sound::Mixer::VOICE_COUNT;
+  
+  // Voices are taken in turn, so the next one in turn is the oldest when none is free
+  int voice = nextVoice;
+  for (int i = 0; i < voiceCount; i++) {
+    int candidate = (nextVoice + i) % voiceCount;
+    if (!M5.Speaker.isPlaying(Config::Sound::Mixer::FIRST_CHANNEL + candidate)) {
+      voice = candidate;
+      break;
+    }
+  }
+  nextVoice = (voice + 1) % voiceCount;
+  
+  // Replace whatever the voice is playing; the speaker mixes all voices
+  M5.Speaker.playRaw(sample.data(), sample.size(), Config::Sound::Mixer::SAMPLE_RATE,
+                     false, 1, Config::Sound::Mixer::FIRST_CHANNEL + voice, true);
+}
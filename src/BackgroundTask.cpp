@@ -0,0 +1,111 @@
+/**
+ * @file BackgroundTask.cpp
+ * @brief Implementation of background task abstraction
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the BackgroundTask class which runs a function
+ * concurrently with the main loop: as a FreeRTOS task pinned to a core on
+ * M5Stack, and as a std::thread in the native PC/SDL environment.
+ */
+
+#include "BackgroundTask.h"
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+// Constructor
+BackgroundTask::BackgroundTask()
+  : function(nullptr),
+    argument(nullptr),
+    stopRequested(false),
+    running(false)
+#ifdef ARDUINO
+    , handle(nullptr)
+#endif
+{
+}
+
+// Destructor
+BackgroundTask::~BackgroundTask() {
+  stop();
+}
+
+// Task entry point
+void BackgroundTask::entry(void* task) {
+  BackgroundTask* self = static_cast<BackgroundTask*>(task);
+  self->function(self->argument);
+  self->running = false;
+#ifdef ARDUINO
+  // FreeRTOS tasks must not return from their function
+  vTaskDelete(nullptr);
+#endif
+}
+
+// Start the task
+bool BackgroundTask::start(const char* name, int core, int priority, uint32_t stackSize,
+                           TaskFunction taskFunction, void* taskArgument) {
+  if (running) {
+    return false;
+  }
+  stop();
+  
+  function = taskFunction;
+  argument = taskArgument;
+  stopRequested = false;
+  running = true;
+  
+#ifdef ARDUINO
+  BaseType_t result = xTaskCreatePinnedToCore(&BackgroundTask::entry, name, stackSize, this, priority,
+                                              &handle, core < 0 ? tskNO_AFFINITY : core);
+  if (result != pdPASS) {
+    running = false;
+    handle = nullptr;
+    return false;
+  }
+#else
+  // Thread names, priorities, cores and stack sizes are left to the host OS
+  (void)name;
+  (void)core;
+  (void)priority;
+  (void)stackSize;
+  thread = std::thread(&BackgroundTask::entry, this);
+#endif
+  return true;
+}
+
+// Ask the task to stop and wait until its function has returned
+void BackgroundTask::stop() {
+  stopRequested = true;
+#ifdef ARDUINO
+  while (running) {
+    sleepFor(1);
+  }
+  handle = nullptr;
+#else
+  if (thread.joinable()) {
+    thread.join();
+  }
+#endif
+}
+
+// Get whether the task is running
+bool BackgroundTask::isRunning() const {
+  return running;
+}
+
+// Get whether the task has been asked to stop
+bool BackgroundTask::isStopRequested() const {
+  return stopRequested;
+}
+
+// Sleep the calling task or thread
+void BackgroundTask::sleepFor(uint32_t milliseconds) {
+#ifdef ARDUINO
+  vTaskDelay(pdMS_TO_TICKS(milliseconds));
+#else
+  std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+#endif
+}
@@ -11,21 +11,28 @@
  */
 
 #include "Block.h"
+#include "Easing.h"
 
 Block::Block(int _x, int _y) : 
+  state(BlockState::FREE), 
   x(_x), y(_y), 
+  fileID(-1),
   targetX(_x), targetY(_y), 
-  animX(_x), animY(_y),
-  state(BlockState::FREE), 
+  animX(FixedPoint::fromInt(_x)), animY(FixedPoint::fromInt(_y)),
+  prevAnimX(FixedPoint::fromInt(_x)), prevAnimY(FixedPoint::fromInt(_y)),
+  startAnimX(FixedPoint::fromInt(_x)), startAnimY(FixedPoint::fromInt(_y)),
+  moveTick(0),
   isMoving(false), 
-  fileID(-1),
-  isExploding(false),
-  explodeVelocityX(0.0f),
-  explodeVelocityY(0.0f) {}
+  moveStartTime(0) {}
 
 // Get the color based on the block's state
 uint16_t Block::getColor() const {
-  switch (state) {
+  return getStateColor(state);
+}
+
+// Get the color of a block state
+uint16_t Block::getStateColor(BlockState blockState) {
+  switch (blockState) {
     case BlockState::FIXED:
       return Colors::Block::FIXED_BACK;
     case BlockState::UNOPT_BEGIN:
@@ -50,16 +57,17 @@ uint16_t Block::getColor() const {
   }
 }
 
-// Draw the block
-void Block::draw(AnimationState animState) {
-  // Use floating-point coordinates during animation (movement or explosion)
-  float useX = (isMoving || isExploding) ? animX : x;
-  float useY = (isMoving || isExploding) ? animY : y;
+// Draw a block in the given state at grid coordinates
+void Block::draw(RenderTarget& target, BlockState blockState, float gridX, float gridY) {
+  int screenX = Config::getGridOffsetX() + gridX * (Config::getBlockWidth() + 2);
+  int screenY = Config::getGridOffsetY() + gridY * (Config::getBlockHeight() + 2);
   
-  int screenX = Config::getGridOffsetX() + useX * (Config::getBlockWidth() + 2);
-  int screenY = Config::getGridOffsetY() + useY * (Config::getBlockHeight() + 2);
+  // Skip blocks outside the band being rendered
+  if (!target.isVisible(screenX, screenY, Config::getBlockWidth(), Config::getBlockHeight())) {
+    return;
+  }
   
-  switch (state) {
+  switch (blockState) {
     // Blocks that are not drawn
     case BlockState::INVISIBLE_FREE:
     case BlockState::INVISIBLE_FIXED_AS_UNOPT_BEGIN:
@@ -75,42 +83,44 @@ void Block::draw(AnimationState animState) {
     // Special drawing for immovable data blocks
     case BlockState::FIXED:
       {
-        uint16_t color = getColor();
-        canvas.fillRect(screenX, screenY, Config::getBlockWidth(), Config::getBlockHeight(), color);
-        canvas.drawRect(screenX, screenY, Config::getBlockWidth(), Config::getBlockHeight(), Colors::Block::FRAME);
+        uint16_t color = getStateColor(blockState);
+        target.fillRect(screenX, screenY, Config::getBlockWidth(), Config::getBlockHeight(), color);
+        target.drawRect(screenX, screenY, Config::getBlockWidth(), Config::getBlockHeight(), Colors::Block::FRAME);
         
         // Special drawing for immovable data (red square in the upper right)
-        canvas.fillRect(screenX + Config::getBlockWidth() / 2, screenY, 
+        target.fillRect(screenX + Config::getBlockWidth() / 2, screenY, 
                       Config::getBlockWidth() / 2, Config::getBlockHeight() / 2, Colors::Block::FIXED_FORE);
-        canvas.drawRect(screenX + Config::getBlockWidth() / 2, screenY, 
+        target.drawRect(screenX + Config::getBlockWidth() / 2, screenY, 
                       Config::getBlockWidth() / 2, Config::getBlockHeight() / 2, Colors::Block::FRAME);
       }
       break;
       
     // Special drawing for bad blocks
     case BlockState::BAD:
-      {
-        uint16_t color = getColor();
-        canvas.fillRect(screenX, screenY, Config::getBlockWidth(), Config::getBlockHeight(), color);
-        canvas.drawRect(screenX, screenY, Config::getBlockWidth(), Config::getBlockHeight(), Colors::Block::FRAME);
-        
-        // Special drawing for bad blocks (diagonal line)
-        canvas.drawLine(screenX + 1, screenY + 1, 
-                      screenX + Config::getBlockWidth() - 2, screenY + Config::getBlockHeight() - 2, Colors::Block::BAD_FORE);
-      }
+      drawBadBlock(target, screenX, screenY);
       break;
       
     // Other blocks to display
     default:
       {
-        uint16_t color = getColor();
-        canvas.fillRect(screenX, screenY, Config::getBlockWidth(), Config::getBlockHeight(), color);
-        canvas.drawRect(screenX, screenY, Config::getBlockWidth(), Config::getBlockHeight(), Colors::Block::FRAME);
+        uint16_t color = getStateColor(blockState);
+        target.fillRect(screenX, screenY, Config::getBlockWidth(), Config::getBlockHeight(), color);
+        target.drawRect(screenX, screenY, Config::getBlockWidth(), Config::getBlockHeight(), Colors::Block::FRAME);
       }
       break;
   }
 }
 
+// Draw a bad block at screen coordinates
+void Block::drawBadBlock(RenderTarget& target, int screenX, int screenY) {
+  target.fillRect(screenX, screenY, Config::getBlockWidth(), Config::getBlockHeight(), Colors::Block::BAD_BACK);
+  target.drawRect(screenX, screenY, Config::getBlockWidth(), Config::getBlockHeight(), Colors::Block::FRAME);
+  
+  // Special drawing for bad blocks (diagonal line)
+  target.drawLine(screenX + 1, screenY + 1, 
+                screenX + Config::getBlockWidth() - 2, screenY + Config::getBlockHeight() - 2, Colors::Block::BAD_FORE);
+}
+
 // Update the block's state in reading drive info phase 1
 void Block::updateStateInDriveInfoPhase1() {
     switch (state) {
@@ -157,37 +167,55 @@ void Block::updateStateInDriveInfoPhase2() {
 }
 
 // Start moving
-void Block::startMoving(int newX, int newY) {
+void Block::startMoving(int fromX, int fromY, int newX, int newY, uint64_t startTime) {
   targetX = newX;
   targetY = newY;
   isMoving = true;
-  // Set the position at the start of animation to the current position
-  animX = x;
-  animY = y;
+  moveStartTime = startTime;
+  moveTick = 0;
+  // Set the position at the start of animation to the source position
+  startAnimX = FixedPoint::fromInt(fromX);
+  startAnimY = FixedPoint::fromInt(fromY);
+  animX = startAnimX;
+  animY = startAnimY;
 }
 
 // Update moving animation in defragmenting
-void Block::updateMoving() {
+void Block::updateMoving(uint64_t now) {
   if (isMoving) {
-    // Gradually move towards the target position
-    float dx = targetX - animX;
-    float dy = targetY - animY;
+    // Remember the position at the previous tick for interpolation
+    prevAnimX = animX;
+    prevAnimY = animY;
     
-    if (abs(dx) < Config::Animation::POSITION_THRESHOLD && abs(dy) < Config::Animation::POSITION_THRESHOLD) {
+    // Stay at the start position until the block's turn in the stagger comes
+    if (now < moveStartTime) {
+      return;
+    }
+    
+    fixed_t endX = FixedPoint::fromInt(targetX);
+    fixed_t endY = FixedPoint::fromInt(targetY);
+    fixed_t dx = endX - animX;
+    fixed_t dy = endY - animY;
+    
+    if ((FixedPoint::absolute(dx) < Config::Animation::POSITION_THRESHOLD &&
+         FixedPoint::absolute(dy) < Config::Animation::POSITION_THRESHOLD) ||
+        moveTick >= Config::Animation::EASING_TICKS) {
       // When close enough, align completely with the target position
-      animX = targetX;
-      animY = targetY;
+      animX = endX;
+      animY = endY;
       isMoving = false;
     } else {
-      // Gradually approach the target position
-      animX += dx * Config::Animation::MOVE_SPEED;
-      animY += dy * Config::Animation::MOVE_SPEED;
+      // Follow the easing curve from the start position to the target position
+      moveTick++;
+      fixed_t progress = Easing::easeOut(moveTick);
+      animX = startAnimX + FixedPoint::multiply(endX - startAnimX, progress);
+      animY = startAnimY + FixedPoint::multiply(endY - startAnimY, progress);
     }
   }
 }
 
-// Start explosion (from touch coordinates)
-void Block::startExploding(int touchX, int touchY) {
+// Get whether the block explodes when the screen is touched
+bool Block::canExplode() const {
   // Invisible or free areas do not explode
   switch (state) {
   case   BlockState::FREE:
@@ -199,45 +227,9 @@ void Block::startExploding(int touchX, int touchY) {
   case   BlockState::INVISIBLE_FIXED_AS_UNOPT_BEGIN:
   case   BlockState::INVISIBLE_FIXED_AS_UNOPT_MIDDLE:
   case   BlockState::INVISIBLE_FIXED_AS_UNOPT_END:
-    return;
-    break;
+    return false;
   
   default:
-    break;
+    return true;
   }
-  isExploding = true;
-  
-  // Calculate the screen coordinates of the block
-  int screenX = Config::getGridOffsetX() + x * (Config::getBlockWidth() + 2) + Config::getBlockWidth() / 2;
-  int screenY = Config::getGridOffsetY() + y * (Config::getBlockHeight() + 2) + Config::getBlockHeight() / 2;
-  
-  // Calculate the direction vector from the touch coordinates (screen coordinate system)
-  float dirX = screenX - touchX;
-  float dirY = screenY - touchY;
-  
-  // Calculate distance (add a small value to prevent division by zero)
-  float distance = sqrt(dirX * dirX + dirY * dirY) + 0.1f;
-  
-  // Normalize the direction vector and set the velocity
-  // Adjust so that the closer to the center, the greater the velocity
-  float speed = 1.0f + (1.0f / distance) * 30.0f;
-  explodeVelocityX = (dirX / distance) * speed;
-  explodeVelocityY = (dirY / distance) * speed;
-  
-  // Change state to BAD
-  state = BlockState::BAD;
-}
-
-// Update explosion animation
-void Block::updateExplosion() {
-  if (!isExploding) {
-    return;
-  }
-  
-  // Apply gravity in the Y-axis direction (increase velocity)
-  explodeVelocityY += Config::Animation::GRAVITY;
-  
-  // Update position
-  animX += explodeVelocityX;
-  animY += explodeVelocityY;
 }
@@ -0,0 +1,520 @@
+/**
+ * @file CompactionPlanner.cpp
+ * @brief Implementation of whole-disk compaction planning
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file implements the CompactionPlanner class. Data is packed into the
+ * first slots (non-fixed cells) of the drive. A unit only takes a run of
+ * slots that are consecutive cells, so no file is laid out across a fixed
+ * block; a file that fits in no such run of the compacted region goes behind
+ * it. Units already lying there in one piece keep their place; the others
+ * are assigned to the remaining slots, largest first (or, sliding, every
+ * unit takes the next slots in disk order, and hot/cold, in order of falling
+ * access heat).
+ * The moves are then ordered so that each one only writes to free cells (or
+ * to its own cells, when it shifts towards the beginning), and when the
+ * remaining moves block each other one of them is parked in the free space
+ * behind the compacted region.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <queue>
+#include "CompactionPlanner.h"
+
+// Constructor
+CompactionPlanner::CompactionPlanner(GridManager& gridManager, FileManager& fileManager, Layout layout)
+  : gridManager(gridManager),
+    fileManager(fileManager),
+    layout(layout),
+    regionSize(0) {
+}
+
+// Convert a cell index to grid coordinates
+std::pair<int, int> CompactionPlanner::toPosition(int cell) const {
+  return std::make_pair(cell % gridManager.getColumnCount(), cell / gridManager.getColumnCount());
+}
+
+// Collect files and optimized blocks, and the slots they can occupy
+void CompactionPlanner::collectUnits() {
+  const int columnCount = gridManager.getColumnCount();
+  std::map<int, int> fileUnits;  // Unit index of each file ID
+
+  units.clear();
+  slotCells.clear();
+  cellSlots.assign(columnCount * gridManager.getRowCount(), -1);
+  regionSize = 0;
+
+  for (int y = 0; y < gridManager.getRowCount(); y++) {
+    for (int x = 0; x < columnCount; x++) {
+      const Block& block = gridManager.getBlock(x, y);
+      int cell = y * columnCount + x;
+      bool isFileBlock = (block.state == BlockState::UNOPT_BEGIN ||
+                          block.state == BlockState::UNOPT_MIDDLE ||
+                          block.state == BlockState::UNOPT_END);
+
+      // Fixed (and bad) blocks never move and never receive data
+      if (!isFileBlock && block.state != BlockState::OPTIMIZED && block.state != BlockState::FREE) {
+        continue;
+      }
+      cellSlots[cell] = slotCells.size();
+      slotCells.push_back(cell);
+      if (block.state == BlockState::FREE) {
+        continue;
+      }
+
+      // Fragmented blocks of a file move together, optimized blocks one by one
+      if (isFileBlock && fileUnits.count(block.fileID) > 0) {
+        units[fileUnits[block.fileID]].cells.push_back(cell);
+      } else {
+        Unit unit;
+        unit.fileID = block.fileID;
+        unit.cells.push_back(cell);
+        unit.isFile = isFileBlock;
+        unit.pinned = false;
+        if (isFileBlock) {
+          fileUnits[block.fileID] = units.size();
+        }
+        units.push_back(unit);
+      }
+      regionSize++;
+    }
+  }
+
+  slotOwners.assign(slotCells.size(), -1);
+}
+
+// Get whether count slots from firstSlot are consecutive cells
+bool CompactionPlanner::isContiguous(int firstSlot, int count) const {
+  int lastSlot = firstSlot + count - 1;
+  return lastSlot < (int)slotCells.size() && slotCells[lastSlot] - slotCells[firstSlot] == count - 1;
+}
+
+// Keep units that already lie contiguously inside the compacted region
+void CompactionPlanner::pinUnits() {
+  for (size_t i = 0; i < units.size(); i++) {
+    Unit& unit = units[i];
+    bool inPlace = true;
+    for (size_t k = 0; k < unit.cells.size() && inPlace; k++) {
+      int slot = cellSlots[unit.cells[k]];
+      inPlace = slot < regionSize && (k == 0 || unit.cells[k] == unit.cells[k - 1] + 1);
+    }
+    if (!inPlace) {
+      continue;
+    }
+
+    unit.pinned = true;
+    unit.targetCells = unit.cells;
+    for (int cell : unit.cells) {
+      slotOwners[cellSlots[cell]] = i;
+    }
+  }
+}
+
+// Assign a run of slots to a unit
+void CompactionPlanner::assignSlots(int unitIndex, int firstSlot) {
+  Unit& unit = units[unitIndex];
+  unit.targetCells.clear();
+  for (size_t k = 0; k < unit.cells.size(); k++) {
+    slotOwners[firstSlot + k] = unitIndex;
+    unit.targetCells.push_back(slotCells[firstSlot + k]);
+  }
+}
+
+// Keep a unit where it is
+void CompactionPlanner::keepInPlace(int unitIndex) {
+  Unit& unit = units[unitIndex];
+  unit.pinned = true;
+  unit.targetCells = unit.cells;
+  for (int cell : unit.cells) {
+    if (slotOwners[cellSlots[cell]] < 0) {
+      slotOwners[cellSlots[cell]] = unitIndex;
+    }
+  }
+}
+
+// Find the first free run of count slots before endSlot
+int CompactionPlanner::findFreeRun(int count, int endSlot) const {
+  int runLength = 0;
+  for (int slot = 0; slot < endSlot; slot++) {
+    // A fixed block between two slots ends the run
+    bool startsRun = slot == 0 || slotCells[slot] != slotCells[slot - 1] + 1;
+    if (slotOwners[slot] >= 0) {
+      runLength = 0;
+    } else {
+      runLength = startsRun ? 1 : runLength + 1;
+    }
+    if (runLength == count) {
+      return slot - count + 1;
+    }
+  }
+  return -1;
+}
+
+// Free a run of count slots by unpinning the fewest blocks
+int CompactionPlanner::makeFreeRun(int count, std::vector<int>& unpinnedUnits) {
+  int bestSlot = -1;
+  int bestCost = 0;
+
+  for (int first = 0; first + count <= regionSize; first++) {
+    if (!isContiguous(first, count)) {
+      continue;
+    }
+
+    // Cost: blocks of pinned units that would have to move (assigned slots cannot be taken)
+    std::vector<int> windowUnits;
+    int cost = 0;
+    bool usable = true;
+    for (int slot = first; slot < first + count && usable; slot++) {
+      int owner = slotOwners[slot];
+      if (owner < 0) {
+        continue;
+      }
+      usable = units[owner].pinned;
+      if (usable && std::find(windowUnits.begin(), windowUnits.end(), owner) == windowUnits.end()) {
+        windowUnits.push_back(owner);
+        cost += units[owner].cells.size();
+      }
+    }
+    if (usable && (bestSlot < 0 || cost < bestCost)) {
+      bestSlot = first;
+      bestCost = cost;
+    }
+  }
+  if (bestSlot < 0) {
+    return -1;
+  }
+
+  // Unpin the units in the way (they are assigned new slots later)
+  for (int slot = bestSlot; slot < bestSlot + count; slot++) {
+    int owner = slotOwners[slot];
+    if (owner < 0) {
+      continue;
+    }
+    Unit& unit = units[owner];
+    unit.pinned = false;
+    unit.targetCells.clear();
+    for (int cell : unit.cells) {
+      if (slotOwners[cellSlots[cell]] == owner) {
+        slotOwners[cellSlots[cell]] = -1;
+      }
+    }
+    unpinnedUnits.push_back(owner);
+  }
+  return bestSlot;
+}
+
+// Decide where every unit that is not pinned goes
+void CompactionPlanner::assignTargets() {
+  std::vector<int> pendingFiles;
+  std::vector<int> pendingSingles;
+  for (size_t i = 0; i < units.size(); i++) {
+    if (units[i].pinned) {
+      continue;
+    }
+    if (units[i].cells.size() > 1) {
+      pendingFiles.push_back(i);
+    } else {
+      pendingSingles.push_back(i);
+    }
+  }
+
+  // Largest files first, each into the first run of free slots that fits it
+  std::stable_sort(pendingFiles.begin(), pendingFiles.end(), [this](int a, int b) {
+    return units[a].cells.size() > units[b].cells.size();
+  });
+
+  for (size_t i = 0; i < pendingFiles.size(); i++) {
+    int unitIndex = pendingFiles[i];
+    int count = units[unitIndex].cells.size();
+    int firstSlot = findFreeRun(count, regionSize);
+    if (firstSlot < 0) {
+      // Make room by moving pinned blocks out of the way
+      std::vector<int> unpinnedUnits;
+      firstSlot = makeFreeRun(count, unpinnedUnits);
+      for (int unpinned : unpinnedUnits) {
+        if (units[unpinned].cells.size() > 1) {
+          pendingFiles.push_back(unpinned);
+        } else {
+          pendingSingles.push_back(unpinned);
+        }
+      }
+    }
+    if (firstSlot < 0) {
+      // The runs between fixed blocks are too short: the file goes behind the compacted region
+      firstSlot = findFreeRun(count, slotCells.size());
+    }
+    if (firstSlot < 0) {
+      // No room at all: the file is optimized where it is
+      keepInPlace(unitIndex);
+      continue;
+    }
+    assignSlots(unitIndex, firstSlot);
+  }
+
+  // Single blocks fill the remaining slots in disk order
+  std::sort(pendingSingles.begin(), pendingSingles.end(), [this](int a, int b) {
+    return units[a].cells[0] < units[b].cells[0];
+  });
+  size_t nextSingle = 0;
+  for (int slot = 0; slot < regionSize && nextSingle < pendingSingles.size(); slot++) {
+    if (slotOwners[slot] < 0) {
+      assignSlots(pendingSingles[nextSingle++], slot);
+    }
+  }
+}
+
+// Slide every unit towards the beginning in disk order
+void CompactionPlanner::assignSlidingTargets() {
+  // Units are collected in the disk order of their first block
+  int nextSlot = 0;
+  for (size_t i = 0; i < units.size(); i++) {
+    assignNextSlots(i, nextSlot);
+  }
+}
+
+// Assign the next slots that hold a unit in consecutive cells
+void CompactionPlanner::assignNextSlots(int unitIndex, int& nextSlot) {
+  Unit& unit = units[unitIndex];
+  int count = unit.cells.size();
+
+  // A gap left before a fixed block by an earlier, larger unit is filled first
+  int gapSlot = findFreeRun(count, nextSlot);
+  if (gapSlot >= 0) {
+    assignSlots(unitIndex, gapSlot);
+    unit.pinned = (unit.targetCells == unit.cells);
+    return;
+  }
+
+  while (nextSlot < (int)slotCells.size() && !isContiguous(nextSlot, count)) {
+    nextSlot++;
+  }
+  if (nextSlot >= (int)slotCells.size()) {
+    // No run left that holds it: the unit is optimized where it is
+    keepInPlace(unitIndex);
+    return;
+  }
+
+  assignSlots(unitIndex, nextSlot);
+  nextSlot += count;
+  unit.pinned = (unit.targetCells == unit.cells);
+}
+
+// Pack the units from the beginning by falling access heat
+void CompactionPlanner::assignHotColdTargets() {
+  // Blocks of one file stay together, in disk order, among the files of the same heat
+  std::vector<int> order;
+  for (size_t i = 0; i < units.size(); i++) {
+    order.push_back(i);
+  }
+  std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+    int heatA = FileManager::getAccessHeat(units[a].fileID);
+    int heatB = FileManager::getAccessHeat(units[b].fileID);
+    if (heatA != heatB) {
+      return heatA > heatB;
+    }
+    return units[a].fileID < units[b].fileID;
+  });
+
+  int nextSlot = 0;
+  for (int unitIndex : order) {
+    assignNextSlots(unitIndex, nextSlot);
+  }
+}
+
+// Extend the compacted region to the last assigned slot
+void CompactionPlanner::extendRegion() {
+  for (int slot = slotOwners.size() - 1; slot >= regionSize; slot--) {
+    if (slotOwners[slot] >= 0) {
+      regionSize = slot + 1;
+      return;
+    }
+  }
+}
+
+// Get whether a move of a unit has to wait until a cell is free
+bool CompactionPlanner::isWaitingFor(const Unit& unit, int cell) const {
+  std::pair<int, int> position = toPosition(cell);
+  if (gridManager.getBlock(position.first, position.second).state == BlockState::FREE) {
+    return false;
+  }
+
+  // A unit shifting towards the beginning may write over its own blocks:
+  // block k only overwrites blocks before it, which are read first
+  return unit.targetCells[0] > unit.cells[0] ||
+         std::find(unit.cells.begin(), unit.cells.end(), cell) == unit.cells.end();
+}
+
+// Get whether a unit can move to its target cells now
+bool CompactionPlanner::isReady(const Unit& unit) const {
+  for (int cell : unit.targetCells) {
+    if (isWaitingFor(unit, cell)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Find free cells outside the compacted region to park a unit
+bool CompactionPlanner::findParkingCells(int count, std::vector<int>& parkingCells) const {
+  parkingCells.clear();
+  for (size_t slot = regionSize; slot < slotCells.size() && (int)parkingCells.size() < count; slot++) {
+    std::pair<int, int> position = toPosition(slotCells[slot]);
+    if (gridManager.getBlock(position.first, position.second).state == BlockState::FREE) {
+      parkingCells.push_back(slotCells[slot]);
+    }
+  }
+  return (int)parkingCells.size() == count;
+}
+
+// Add a move of a unit to cells and apply it to the grid
+void CompactionPlanner::addMove(Unit& unit, const std::vector<int>& toCells, std::vector<PlannedMove>& moves) {
+  PlannedMove move;
+  move.fileID = unit.fileID;
+  for (size_t k = 0; k < unit.cells.size(); k++) {
+    move.fileBlocks.push_back(toPosition(unit.cells[k]));
+    move.targetPositions.push_back(toPosition(toCells[k]));
+  }
+  fileManager.completePlannedMove(move);
+  moves.push_back(move);
+  unit.cells = toCells;
+}
+
+// Order the moves so that each one only writes to free cells
+void CompactionPlanner::orderMoves(std::vector<PlannedMove>& moves) {
+  // Files already in place (or without room) are optimized in place by a single first move
+  PlannedMove inPlace;
+  inPlace.fileID = -1;
+  std::vector<int> order;
+  for (size_t i = 0; i < units.size(); i++) {
+    const Unit& unit = units[i];
+    if (unit.pinned || unit.targetCells.empty()) {
+      if (unit.isFile) {
+        for (int cell : unit.cells) {
+          inPlace.fileBlocks.push_back(toPosition(cell));
+        }
+      }
+    } else {
+      order.push_back(i);
+    }
+  }
+  if (!inPlace.fileBlocks.empty()) {
+    fileManager.completePlannedMove(inPlace);
+    moves.push_back(inPlace);
+  }
+
+  // Moves sweep from the beginning of the drive: sort by the first target slot
+  std::sort(order.begin(), order.end(), [this](int a, int b) {
+    return units[a].targetCells[0] < units[b].targetCells[0];
+  });
+
+  // Count the occupied target cells each move waits for
+  std::vector<int> orderIndex(units.size(), -1);
+  std::vector<int> waitingCells(order.size(), 0);
+  std::priority_queue<int, std::vector<int>, std::greater<int>> readyMoves;
+  for (size_t i = 0; i < order.size(); i++) {
+    orderIndex[order[i]] = i;
+    for (int cell : units[order[i]].targetCells) {
+      if (isWaitingFor(units[order[i]], cell)) {
+        waitingCells[i]++;
+      }
+    }
+    if (waitingCells[i] == 0) {
+      readyMoves.push(i);
+    }
+  }
+
+  std::vector<bool> done(order.size(), false);
+  size_t nextParkCandidate = 0;
+  size_t doneCount = 0;
+  while (doneCount < order.size()) {
+    int index;
+    std::vector<int> toCells;
+    if (!readyMoves.empty()) {
+      // Move the earliest unit whose target cells are all free
+      index = readyMoves.top();
+      readyMoves.pop();
+      if (done[index] || !isReady(units[order[index]])) {
+        continue;
+      }
+      toCells = units[order[index]].targetCells;
+      done[index] = true;
+      doneCount++;
+    } else {
+      // The remaining moves block each other: park a unit that sits inside the compacted region
+      // (units outside the region never block, so the candidate only moves forward)
+      auto isInRegion = [this](int cell) { return cellSlots[cell] < regionSize; };
+      while (nextParkCandidate < order.size() &&
+             (done[nextParkCandidate] ||
+              std::none_of(units[order[nextParkCandidate]].cells.begin(),
+                           units[order[nextParkCandidate]].cells.end(), isInRegion))) {
+        nextParkCandidate++;
+      }
+      if (nextParkCandidate >= order.size() ||
+          !findParkingCells(units[order[nextParkCandidate]].cells.size(), toCells)) {
+        // No free space to break the deadlock: the remaining files are optimized where they are
+        PlannedMove remaining;
+        remaining.fileID = -1;
+        for (size_t i = 0; i < order.size(); i++) {
+          if (!done[i] && units[order[i]].isFile) {
+            for (int cell : units[order[i]].cells) {
+              remaining.fileBlocks.push_back(toPosition(cell));
+            }
+          }
+        }
+        if (!remaining.fileBlocks.empty()) {
+          fileManager.completePlannedMove(remaining);
+          moves.push_back(remaining);
+        }
+        return;
+      }
+      index = nextParkCandidate;
+    }
+
+    // Cells left behind may be the last ones another move waits for
+    std::vector<int> freedCells = units[order[index]].cells;
+    addMove(units[order[index]], toCells, moves);
+    for (int cell : freedCells) {
+      int slot = cellSlots[cell];
+      int owner = (slot < regionSize) ? slotOwners[slot] : -1;
+      if (owner < 0 || owner == order[index] || orderIndex[owner] < 0 || done[orderIndex[owner]]) {
+        continue;
+      }
+      if (--waitingCells[orderIndex[owner]] == 0) {
+        readyMoves.push(orderIndex[owner]);
+      }
+    }
+
+    // A parked unit no longer shifts over its own blocks: count what it waits for again
+    if (!done[index]) {
+      waitingCells[index] = 0;
+      for (int cell : units[order[index]].targetCells) {
+        if (isWaitingFor(units[order[index]], cell)) {
+          waitingCells[index]++;
+        }
+      }
+      if (waitingCells[index] == 0) {
+        readyMoves.push(index);
+      }
+    }
+  }
+}
+
+// Plan all moves of the compaction
+void CompactionPlanner::plan(std::vector<PlannedMove>& moves) {
+  moves.clear();
+  collectUnits();
+  if (layout == Layout::SLIDING) {
+    assignSlidingTargets();
+  } else if (layout == Layout::HOT_COLD) {
+    assignHotColdTargets();
+  } else {
+    pinUnits();
+    assignTargets();
+  }
+  extendRegion();
+  orderMoves(moves);
+}
@@ -87,6 +87,20 @@ void Config::initialize(int width, int height) {
     progressBarOffsetX = (screenWidth - progressBarWidth) / 2;
 }
 
+// ========================================
+// Screen configuration getters
+// ========================================
+
+// Get the screen width
+int Config::getScreenWidth() {
+    return getInstance()->screenWidth;
+}
+
+// Get the screen height
+int Config::getScreenHeight() {
+    return getInstance()->screenHeight;
+}
+
 // ========================================
 // Grid configuration getters
 // ========================================
@@ -0,0 +1,87 @@
+/**
+ * @file ConsolidationPlanner.cpp
+ * @brief Implementation of free-space consolidation planning
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file implements the ConsolidationPlanner class. Extents (runs of
+ * optimized blocks of one file) are visited in disk order, and each slides
+ * to the first cell behind the previous extent where it fits.
+ */
+
+#include "ConsolidationPlanner.h"
+
+// Constructor
+ConsolidationPlanner::ConsolidationPlanner(const GridManager& gridManager)
+  : gridManager(gridManager) {
+}
+
+// Convert a cell index to grid coordinates
+std::pair<int, int> ConsolidationPlanner::toPosition(int cell) const {
+  return std::make_pair(cell % gridManager.getColumnCount(), cell / gridManager.getColumnCount());
+}
+
+// Find the first cell from firstCell where count cells hold no fixed block
+int ConsolidationPlanner::findRoom(int firstCell, int lastCell, int count) const {
+  // Data before lastCell belongs to extents already slid in front of firstCell, so only fixed blocks are in the way
+  int runStart = firstCell;
+  for (int cell = firstCell; cell < lastCell && cell < runStart + count; cell++) {
+    std::pair<int, int> position = toPosition(cell);
+    BlockState state = gridManager.getBlock(position.first, position.second).state;
+    if (state == BlockState::FIXED || state == BlockState::BAD) {
+      runStart = cell + 1;
+    }
+  }
+  return (runStart < lastCell) ? runStart : lastCell;
+}
+
+// Add the moves sliding the blocks of an extent from sourceCell to targetCell
+void ConsolidationPlanner::addSlideMoves(int fileID, int sourceCell, int targetCell, int count,
+                                         std::vector<PlannedMove>& moves) const {
+  // Pieces no longer than the distance only write to cells already left by the previous piece
+  int distance = sourceCell - targetCell;
+  for (int first = 0; first < count; first += distance) {
+    PlannedMove move;
+    move.fileID = fileID;
+    for (int i = first; i < count && i < first + distance; i++) {
+      move.fileBlocks.push_back(toPosition(sourceCell + i));
+      move.targetPositions.push_back(toPosition(targetCell + i));
+    }
+    moves.push_back(move);
+  }
+}
+
+// Plan all moves of the consolidation
+void ConsolidationPlanner::plan(std::vector<PlannedMove>& moves) const {
+  const int cellCount = gridManager.getColumnCount() * gridManager.getRowCount();
+  int writeCell = 0;  // First cell behind the data slid so far
+
+  moves.clear();
+  for (int cell = 0; cell < cellCount; cell++) {
+    std::pair<int, int> position = toPosition(cell);
+    const Block& block = gridManager.getBlock(position.first, position.second);
+    if (block.state != BlockState::OPTIMIZED) {
+      continue;
+    }
+
+    // The extent runs while the blocks belong to the same file
+    int endCell = cell + 1;
+    while (endCell < cellCount) {
+      std::pair<int, int> nextPosition = toPosition(endCell);
+      const Block& nextBlock = gridManager.getBlock(nextPosition.first, nextPosition.second);
+      if (nextBlock.state != BlockState::OPTIMIZED || nextBlock.fileID != block.fileID) {
+        break;
+      }
+      endCell++;
+    }
+
+    int count = endCell - cell;
+    int targetCell = findRoom(writeCell, cell, count);
+    if (targetCell < cell) {
+      addSlideMoves(block.fileID, cell, targetCell, count, moves);
+    }
+    writeCell = targetCell + count;
+    cell = endCell - 1;
+  }
+}
@@ -0,0 +1,111 @@
+/**
+ * @file CopyEngine.cpp
+ * @brief Implementation of buffered copy engine
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the CopyEngine class which gathers planned moves
+ * into batches that fit in the staging buffer.
+ */
+
+#include "CopyEngine.h"
+#include <algorithm>
+
+// Constructor
+CopyEngine::CopyEngine(int capacity)
+  : capacity(capacity),
+    columnCount(0),
+    hasPendingMove(false) {
+  batch.fileID = -1;
+}
+
+// Reset
+void CopyEngine::reset(int columnCount, int rowCount) {
+  this->columnCount = columnCount;
+  batch.fileID = -1;
+  batch.fileBlocks.clear();
+  batch.targetPositions.clear();
+  writtenCells.assign(columnCount * rowCount, false);
+  hasPendingMove = false;
+}
+
+// Get whether another move can be staged
+bool CopyEngine::hasRoom() const {
+  if (hasPendingMove) {
+    return false;
+  }
+  return batch.fileBlocks.empty() || (int)batch.fileBlocks.size() < capacity;
+}
+
+// Stage a move with targets
+void CopyEngine::addMove(const PlannedMove& move) {
+  pendingMove = move;
+  hasPendingMove = true;
+  stagePendingMove();
+}
+
+// Stage as many blocks of the pending move as the buffer has room for
+bool CopyEngine::stagePendingMove() {
+  // Data written by this batch is not in place until the batch has landed
+  for (const auto &position : pendingMove.fileBlocks) {
+    if (writtenCells[position.second * columnCount + position.first]) {
+      return false;
+    }
+  }
+
+  // Without a buffer a file is copied on its own
+  size_t count = pendingMove.fileBlocks.size();
+  if (capacity > 0) {
+    count = std::min(count, (size_t)(capacity - (int)batch.fileBlocks.size()));
+  } else if (!batch.fileBlocks.empty()) {
+    return false;
+  }
+  if (count == 0) {
+    return false;
+  }
+
+  if (batch.fileBlocks.empty()) {
+    batch.fileID = pendingMove.fileID;
+  }
+  for (size_t i = 0; i < count; i++) {
+    const std::pair<int, int>& target = pendingMove.targetPositions[i];
+    batch.fileBlocks.push_back(pendingMove.fileBlocks[i]);
+    batch.targetPositions.push_back(target);
+    writtenCells[target.second * columnCount + target.first] = true;
+  }
+
+  // The rest of the file waits for the next batch
+  pendingMove.fileBlocks.erase(pendingMove.fileBlocks.begin(), pendingMove.fileBlocks.begin() + count);
+  pendingMove.targetPositions.erase(pendingMove.targetPositions.begin(), pendingMove.targetPositions.begin() + count);
+  hasPendingMove = !pendingMove.fileBlocks.empty();
+  return true;
+}
+
+// Take the staged batch as one move
+bool CopyEngine::takeBatch(PlannedMove& move) {
+  // A move that did not fit the previous batch starts this one
+  if (batch.fileBlocks.empty() && hasPendingMove) {
+    stagePendingMove();
+  }
+  if (batch.fileBlocks.empty()) {
+    return false;
+  }
+
+  move = batch;
+  batch.fileID = -1;
+  batch.fileBlocks.clear();
+  batch.targetPositions.clear();
+  writtenCells.assign(writtenCells.size(), false);
+  return true;
+}
+
+// Get whether the batch is copied through the staging buffer
+bool CopyEngine::isStaged() const {
+  return capacity > 0;
+}
+
+// Get the number of blocks the staging buffer holds
+int CopyEngine::getCapacity() const {
+  return capacity;
+}
@@ -11,19 +11,32 @@
  */
 
 #include "DefragSimulator.h"
+#include <algorithm>
 #include "PlatformCompat.h"
 
 // Constructor
 DefragSimulator::DefragSimulator() 
   : gridManager(),
     fileManager(gridManager),
+    ioSchedulers(Config::Planner::HEAD_COUNT),
+    copyEngines(Config::Planner::HEAD_COUNT),
     animationManager(gridManager),
     uiRenderer(),
     soundManager(gridManager.getRNG()),
+    simulationTime(0),
+    isPlanning(false),
+    allMovesTaken(false),
+    startedBlockCount(0),
+    consolidationEnabled(Config::Consolidation::ENABLED),
+    nextConsolidationMove(0),
+    consolidationBlockCount(0),
     completedStateStartTime(0),
     isInCompletedState(false),
+    isInTouchState(false),
     touchStateStartTime(0),
-    isInTouchState(false) {
+    lastDrawnAlpha(1.0f),
+    measuredInputTimestamp(0),
+    lastInputTimestamp(0) {
   
   // Set initial state
   uiRenderer.setState(AnimationState::READING_DRIVE_INFO_PHASE1);
@@ -37,9 +50,34 @@ void DefragSimulator::initialize() {
   // Initialize sound class
   soundManager.initialize();
 
+  // Start the animation
+  restart();
+}
+
+// Start the animation from reading drive information
+void DefragSimulator::restart() {
+  // Initialize hit counter
+  uiRenderer.resetHitCounter();
+
   // Initial animation state is reading drive information phase 1
   setState(AnimationState::READING_DRIVE_INFO_PHASE1);
   uiRenderer.setCompletionPercentage(0);
+  uiRenderer.setPlanSummary(-1, -1);
+  uiRenderer.setDiskStatus(0, 0, 0);
+  uiRenderer.setTraceSeekDistances(0, 0);
+  isPlanning = false;
+  allMovesTaken = false;
+  startedBlockCount = 0;
+  consolidationMoves.clear();
+  nextConsolidationMove = 0;
+  consolidationBlockCount = 0;
+  headMoves.assign(Config::Planner::HEAD_COUNT, PlannedMove());
+  for (auto &ioScheduler : ioSchedulers) {
+    ioScheduler.reset(gridManager.getColumnCount(), gridManager.getRowCount());
+  }
+  for (auto &copyEngine : copyEngines) {
+    copyEngine.reset(gridManager.getColumnCount(), gridManager.getRowCount());
+  }
   
   // Reset completion state flag
   completedStateStartTime = 0;
@@ -55,6 +93,10 @@ void DefragSimulator::initialize() {
 
 // Reset
 void DefragSimulator::reset() {
+  // Discard the moves planned for the old grid
+  movePlanner.stop();
+  multiHeadPlanner.stop();
+  
   // Create a new grid manager
   gridManager = GridManager();
   
@@ -65,13 +107,29 @@ void DefragSimulator::reset() {
   animationManager.reset();
   
   // Set initial state
-  initialize();
+  restart();
 }
 
-// Update process
+// Update process (one fixed simulation tick)
 void DefragSimulator::update() {
+  // Handle input events posted since the last update
+  InputEvent event;
+  while (pendingInputEvents.pop(event)) {
+    if (event.type == InputEventType::TOUCH_PRESSED) {
+      handleTouch(event.x, event.y);
+      lastInputTimestamp = event.timestamp;
+    } else if (event.type == InputEventType::BUTTON_B_CLICKED) {
+      consolidationEnabled = !consolidationEnabled;
+    }
+  }
+  
   AnimationState state = uiRenderer.getState();
   int completionPercentage = 0;
+  int blocksInFlight = 0;
+  const uint64_t resetDelay = (uint64_t)Config::Animation::RESET_DELAY * 1000;
+  
+  // Advance simulated time
+  simulationTime += Config::Animation::TICK_INTERVAL;
   
   switch (state) {
     case AnimationState::READING_DRIVE_INFO_PHASE1:
@@ -97,37 +155,66 @@ void DefragSimulator::update() {
       completionPercentage = animationManager.calculateDriveInfoPhasesCompletionPercentage();
       uiRenderer.setCompletionPercentage(completionPercentage);
       
-      // Check if scan is complete
-      if (animationManager.isDriveInfoPhase2ScanCompleted()) {
-        // Change animation state to DEFRAGMENTING
+      // Change animation state to DEFRAGMENTING once the planner has begun
+      // (the scan stays on screen while a whole-drive plan is computed, from the tick after the scan at the earliest)
+      if (isPlanning && isPlannerReady()) {
         uiRenderer.setState(AnimationState::DEFRAGMENTING);
+        break;
+      }
+      
+      // Check if scan is complete
+      if (animationManager.isDriveInfoPhase2ScanCompleted() && !isPlanning) {
+        // Measure the access trace on the layout before any file moves
+        accessTrace.generate(gridManager);
+        traceBeforeDefrag = accessTrace.replay(gridManager);
+        
+        // Start planning the file moves on the grid as it is now
+        if (Config::Planner::HEAD_COUNT > 1) {
+          multiHeadPlanner.begin(gridManager, fileManager);
+        } else {
+          movePlanner.begin(gridManager);
+        }
+        isPlanning = true;
       }
       break;
   
     case AnimationState::DEFRAGMENTING:
-      // Update defrag step
-      animationManager.incrementDefragStep();
+      // Move the planned files
+      updateMoves();
       
-      // If not moving a file, start moving a new file
-      if (!fileManager.isMoving() && 
-          animationManager.getDefragStep() % Config::Animation::DEFRAG_STEP_INTERVAL == 0) {
-        fileManager.moveNextFile();
+      // Update progress
+      // (compaction may still move optimized blocks after the last fragmented file)
+      completionPercentage = animationManager.calculateDefragmentingCompletionPercentage();
+      if (!allMovesTaken) {
+        completionPercentage = std::min(completionPercentage, 99);
       }
+      uiRenderer.setCompletionPercentage(completionPercentage);
       
-      // Update blocks
-      animationManager.updateBlocksInDefragmenting();
+      // Check if all fragmented files have been moved
+      if (completionPercentage >= 100) {
+        if (consolidationEnabled) {
+          startConsolidation();
+        } else {
+          uiRenderer.setState(AnimationState::COMPLETED);
+        }
+      }
+      break;
       
-      // Update file movement
-      fileManager.updateFileMovement();
+    case AnimationState::CONSOLIDATING:
+      // Slide the files
+      blocksInFlight = updateMoves();
       
-      // Update progress
-      completionPercentage = animationManager.calculateDefragmentingCompletionPercentage();
+      // Update progress (blocks of the consolidation that have arrived)
+      completionPercentage = 100;
+      if (consolidationBlockCount > 0) {
+        completionPercentage = (startedBlockCount - blocksInFlight) * 100 / consolidationBlockCount;
+      }
+      if (!allMovesTaken) {
+        completionPercentage = std::min(completionPercentage, 99);
+      }
       uiRenderer.setCompletionPercentage(completionPercentage);
       
-      // Play seek sound
-      soundManager.playSeekSound();
-      
-      // Check if all fragmented files have been moved
+      // Check if all files have slid into place
       if (completionPercentage >= 100) {
         uiRenderer.setState(AnimationState::COMPLETED);
       }
@@ -136,12 +223,18 @@ void DefragSimulator::update() {
     case AnimationState::COMPLETED:
       // If it's the first time entering COMPLETED state, record the time
       if (!isInCompletedState) {
-        completedStateStartTime = millis();
+        completedStateStartTime = simulationTime;
         isInCompletedState = true;
+        
+        // Replay the same access trace on the defragmented layout
+        if (!accessTrace.isEmpty()) {
+          TraceReplay traceAfterDefrag = accessTrace.replay(gridManager);
+          uiRenderer.setTraceSeekDistances(traceBeforeDefrag.seekDistance, traceAfterDefrag.seekDistance);
+        }
       }
       
       // Reset after the set time has elapsed
-      if (millis() - completedStateStartTime >= Config::Animation::RESET_DELAY) {
+      if (simulationTime - completedStateStartTime >= resetDelay) {
         reset();
       }
       break;
@@ -149,29 +242,246 @@ void DefragSimulator::update() {
     case AnimationState::TOUCHED:
       // If it's the first time entering TOUCHED state, record the time
       if (!isInTouchState) {
-        touchStateStartTime = millis();
+        touchStateStartTime = simulationTime;
         isInTouchState = true;
       }  
       
       // Update explosion animation
-      for (int y = 0; y < gridManager.getRowCount(); y++) {
-        for (int x = 0; x < gridManager.getColumnCount(); x++) {
-          Block& block = gridManager.getBlock(x, y);
-          block.updateExplosion();
-        }
-      }
+      animationManager.updateExplosion();
       
-      // Reset after the set time has elapsed
-      if (millis() - touchStateStartTime >= Config::Animation::RESET_DELAY) {
+      // Reset once all debris has left the screen, or after the set time has elapsed
+      if (animationManager.isExplosionFinished() ||
+          simulationTime - touchStateStartTime >= resetDelay) {
         reset();
       }
       break;
   }
+  
+  // Fragmentation of the drive after this tick (kept current by the grid on every block change)
+  uiRenderer.setFragmentation(gridManager.getFragmentationMetrics().getSummary());
+}
+
+// Get whether the first planned move can be taken without waiting for a whole-drive plan
+bool DefragSimulator::isPlannerReady() const {
+  // The heads of the multi-head planner plan one move at a time
+  return Config::Planner::HEAD_COUNT > 1 || movePlanner.hasBegun();
+}
+
+// Get whether the simulation waits for the planner to begin
+bool DefragSimulator::isWaitingForPlanner() const {
+  return getState() == AnimationState::READING_DRIVE_INFO_PHASE2 && isPlanning && !isPlannerReady();
+}
+
+// Take the next planned move of a head
+bool DefragSimulator::takeNextMove(int head, PlannedMove& move) {
+  if (getState() == AnimationState::CONSOLIDATING) {
+    // Files slide in disk order, so the first head moves them all
+    if (head != 0 || nextConsolidationMove >= consolidationMoves.size()) {
+      return false;
+    }
+    move = consolidationMoves[nextConsolidationMove++];
+    return true;
+  }
+  
+  if (Config::Planner::HEAD_COUNT > 1) {
+    return multiHeadPlanner.takeNextMove(head, move);
+  }
+  return movePlanner.takeNextMove(move);
+}
+
+// Start the next planned moves
+void DefragSimulator::startNextMoves() {
+  // Every head whose last batch has arrived copies its next one
+  allMovesTaken = true;
+  for (int head = 0; head < Config::Planner::HEAD_COUNT; head++) {
+    CopyEngine& copyEngine = copyEngines[head];
+    if (!fileManager.isMoveFinished(headMoves[head])) {
+      allMovesTaken = false;
+      continue;
+    }
+    
+    // Fill the staging buffer with the next planned moves
+    PlannedMove move;
+    while (copyEngine.hasRoom() && takeNextMove(head, move)) {
+      if (move.targetPositions.empty()) {
+        // Files optimized in place are not copied
+        fileManager.applyPlannedMove(move, simulationTime);
+      } else {
+        copyEngine.addMove(move);
+      }
+    }
+    
+    if (copyEngine.takeBatch(headMoves[head])) {
+      ioSchedulers[head].schedule(headMoves[head], copyEngine.isStaged(), simulationTime);
+      fileManager.applyPlannedMove(headMoves[head], simulationTime);
+      startedBlockCount += headMoves[head].targetPositions.size();
+      allMovesTaken = false;
+    } else {
+      headMoves[head] = PlannedMove();
+    }
+  }
+  
+  // Show the size of the compaction plan once it is known
+  if (Config::Planner::HEAD_COUNT == 1) {
+    uiRenderer.setPlanSummary(movePlanner.getPlannedMoveCount(), movePlanner.getPlannedBlockCount());
+  }
+}
+
+// Advance the copies of the current pass
+int DefragSimulator::updateMoves() {
+  // Update defrag step
+  animationManager.incrementDefragStep();
+  
+  // Start moving the next planned files
+  if (animationManager.getDefragStep() % Config::Animation::DEFRAG_STEP_INTERVAL == 0) {
+    startNextMoves();
+  }
+  
+  // Update blocks
+  animationManager.updateBlocksInDefragmenting(simulationTime);
+  
+  // Update file movement
+  fileManager.updateFileMovement();
+  
+  // Blocks of the batches still being copied occupy the staging buffers
+  int blocksInFlight = 0;
+  for (const auto &move : headMoves) {
+    blocksInFlight += fileManager.countBlocksInFlight(move);
+  }
+  uiRenderer.setBufferOccupancy(blocksInFlight, Config::Copy::STAGING_BLOCKS * Config::Planner::HEAD_COUNT);
+  
+  // Time the copies started so far take on the drive
+  updateDiskStatus();
+  
+  // Play seek sound
+  soundManager.playSeekSound();
+  return blocksInFlight;
+}
+
+// Start consolidating the free space
+void DefragSimulator::startConsolidation() {
+  // Compaction has packed the files already (the heads of the multi-head planner move files first-fit)
+  if (Config::Planner::HEAD_COUNT == 1 && DefragStrategy::compactsFreeSpace(Config::Planner::STRATEGY)) {
+    uiRenderer.setState(AnimationState::COMPLETED);
+    return;
+  }
+  
+  ConsolidationPlanner consolidationPlanner(gridManager);
+  consolidationPlanner.plan(consolidationMoves);
+  nextConsolidationMove = 0;
+  consolidationBlockCount = 0;
+  for (const auto &move : consolidationMoves) {
+    consolidationBlockCount += move.targetPositions.size();
+  }
+  
+  if (consolidationMoves.empty()) {
+    uiRenderer.setState(AnimationState::COMPLETED);
+    return;
+  }
+  
+  // The consolidation is a pass of its own
+  startedBlockCount = 0;
+  allMovesTaken = false;
+  uiRenderer.setCompletionPercentage(0);
+  uiRenderer.setState(AnimationState::CONSOLIDATING);
+}
+
+// Show the time the copies take on the drive
+void DefragSimulator::updateDiskStatus() {
+  // The heads work in parallel: the drive is busy as long as the busiest head
+  uint64_t elapsedTime = 0;
+  uint64_t transferredBytes = 0;
+  for (const auto &ioScheduler : ioSchedulers) {
+    elapsedTime = std::max(elapsedTime, ioScheduler.getDiskModel().getElapsedTime());
+    transferredBytes += ioScheduler.getDiskModel().getTransferredBytes();
+  }
+  uint64_t throughput = (elapsedTime > 0) ? transferredBytes * 1000000 / elapsedTime : 0;
+  
+  // Blocks left to copy (known exactly for the consolidation, and once a compaction plan has been made)
+  int remainingBlocks = animationManager.countUnoptimizedBlocks();
+  if (getState() == AnimationState::CONSOLIDATING) {
+    remainingBlocks = consolidationBlockCount - startedBlockCount;
+  } else if (Config::Planner::HEAD_COUNT == 1 && movePlanner.getPlannedBlockCount() >= 0) {
+    remainingBlocks = std::max(0, movePlanner.getPlannedBlockCount() - startedBlockCount);
+  }
+  
+  // Each head copies its share of the remaining blocks at its own pace
+  uint64_t remainingTime = 0;
+  int headRemainingBlocks = (remainingBlocks + Config::Planner::HEAD_COUNT - 1) / Config::Planner::HEAD_COUNT;
+  for (const auto &ioScheduler : ioSchedulers) {
+    remainingTime = std::max(remainingTime, ioScheduler.getDiskModel().estimateCopyTime(headRemainingBlocks));
+  }
+  
+  uiRenderer.setDiskStatus(elapsedTime, throughput, remainingTime);
+}
+
+// Publish the current state for the renderer
+void DefragSimulator::publishSnapshot(bool interpolate) {
+  RenderSnapshot& snapshot = snapshots.getWriteBuffer();
+  snapshot.capture(gridManager, animationManager);
+  uiRenderer.captureStatus(snapshot);
+  snapshot.inputTimestamp = lastInputTimestamp;
+  snapshot.interpolate = interpolate;
+  snapshot.publishTime = micros64();
+  snapshots.publish();
+}
+
+// Draw the latest published snapshot
+bool DefragSimulator::drawLatestSnapshot() {
+  bool isNew = snapshots.acquire();
+  const RenderSnapshot& snapshot = snapshots.getReadBuffer();
+  if (!snapshot.valid) {
+    return false;
+  }
+  
+  // Show the previous tick at publish time and reach the snapshot's tick one tick interval later
+  float alpha = 1.0f;
+  if (snapshot.interpolate) {
+    uint64_t elapsed = micros64() - snapshot.publishTime;
+    alpha = std::min(1.0f, (float)elapsed / Config::Animation::TICK_INTERVAL);
+  }
+  
+  // Nothing moves until the next snapshot arrives
+  if (!isNew && lastDrawnAlpha >= 1.0f) {
+    return false;
+  }
+  
+  uiRenderer.draw(snapshot, alpha);
+  lastDrawnAlpha = alpha;
+  measureInputLatency(snapshot);
+  return true;
+}
+
+// Measure the input-to-photon latency
+void DefragSimulator::measureInputLatency(const RenderSnapshot& snapshot) {
+  // The frame showing the input's effect has just been handed to the display
+  if (snapshot.inputTimestamp != 0 && snapshot.inputTimestamp != measuredInputTimestamp) {
+    measuredInputTimestamp = snapshot.inputTimestamp;
+    uiRenderer.setInputLatency(micros64() - snapshot.inputTimestamp);
+  }
 }
 
-// Draw grid and UI elements
-void DefragSimulator::draw() {
-  uiRenderer.draw(gridManager, animationManager);
+// Publish and draw the current state on the calling thread
+void DefragSimulator::draw(float alpha) {
+  publishSnapshot(false);
+  snapshots.acquire();
+  uiRenderer.draw(snapshots.getReadBuffer(), alpha);
+  measureInputLatency(snapshots.getReadBuffer());
+}
+
+// Draw the snapshot drawn last once more
+void DefragSimulator::redrawSnapshot(float alpha) {
+  uiRenderer.draw(snapshots.getReadBuffer(), alpha);
+}
+
+// Get the snapshot drawn last
+const RenderSnapshot& DefragSimulator::getDrawnSnapshot() const {
+  return snapshots.getReadBuffer();
+}
+
+// Create the canvases and raster threads of a render setup anew
+bool DefragSimulator::applyRenderSetup(const RenderSetup& setup) {
+  return uiRenderer.applyRenderSetup(setup);
 }
 
 // Get state
@@ -196,30 +506,41 @@ void DefragSimulator::handleTouch(int x, int y) {
   setAllBlocksToBAD(x, y);
 }
 
+// Post an input event from loop()
+void DefragSimulator::postInputEvent(const InputEvent& event) {
+  pendingInputEvents.push(event);
+}
+
 // Explode all blocks
 void DefragSimulator::setAllBlocksToBAD(int touchX, int touchY) {
   // Start explosion animation for all blocks
-  for (int y = 0; y < gridManager.getRowCount(); y++) {
-    for (int x = 0; x < gridManager.getColumnCount(); x++) {
-      Block& block = gridManager.getBlock(x, y);
-      // Explode blocks other than invisible or free areas
-      switch (block.state) {
-      case   BlockState::FREE:
-      case   BlockState::INVISIBLE_UNOPT_BEGIN:
-      case   BlockState::INVISIBLE_UNOPT_MIDDLE:
-      case   BlockState::INVISIBLE_UNOPT_END:
-      case   BlockState::INVISIBLE_OPTIMIZED:
-      case   BlockState::INVISIBLE_FIXED_AS_UNOPT_BEGIN:
-      case   BlockState::INVISIBLE_FIXED_AS_UNOPT_MIDDLE:
-      case   BlockState::INVISIBLE_FIXED_AS_UNOPT_END:
-        break;
-      
-      default:
-            block.startExploding(touchX, touchY);
-      }
-    }
-  }
+  animationManager.startExplosion(touchX, touchY);
   
   // Play explosion sound
   soundManager.playExplosionSound();
 }
+
+// Get the grid of the simulated drive
+const GridManager& DefragSimulator::getGridManager() const {
+  return gridManager;
+}
+
+// Enable or disable the free-space consolidation
+void DefragSimulator::setConsolidationEnabled(bool enabled) {
+  consolidationEnabled = enabled;
+}
+
+// Get whether the free-space consolidation is enabled
+bool DefragSimulator::isConsolidationEnabled() const {
+  return consolidationEnabled;
+}
+
+// Enable or disable sound output
+void DefragSimulator::setSoundEnabled(bool enabled) {
+  soundManager.setEnabled(enabled);
+}
+
+// Set the turbo factor shown in the UI
+void DefragSimulator::setTurboFactor(int turboFactor) {
+  uiRenderer.setTurboFactor(turboFactor);
+}
@@ -0,0 +1,236 @@
+/**
+ * @file DefragStrategy.cpp
+ * @brief Implementation of strategies choosing the file moves of the defragmentation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file implements the DefragStrategy implementations: first-fit,
+ * best-fit, largest-file-first, most-fragmented-first, sliding compaction,
+ * whole-disk compaction with the fewest moves and hot/cold compaction.
+ */
+
+#include "DefragStrategy.h"
+
+// Create a strategy
+std::unique_ptr<DefragStrategy> DefragStrategy::create(DefragStrategyType type) {
+  switch (type) {
+    case DefragStrategyType::BEST_FIT:
+      return std::unique_ptr<DefragStrategy>(new BestFitStrategy());
+    case DefragStrategyType::LARGEST_FILE_FIRST:
+      return std::unique_ptr<DefragStrategy>(new LargestFileFirstStrategy());
+    case DefragStrategyType::MOST_FRAGMENTED_FIRST:
+      return std::unique_ptr<DefragStrategy>(new MostFragmentedFirstStrategy());
+    case DefragStrategyType::SLIDING_COMPACTION:
+      return std::unique_ptr<DefragStrategy>(new CompactionStrategy(CompactionPlanner::Layout::SLIDING));
+    case DefragStrategyType::WHOLE_DISK_COMPACTION:
+      return std::unique_ptr<DefragStrategy>(new CompactionStrategy(CompactionPlanner::Layout::FEWEST_MOVES));
+    case DefragStrategyType::HOT_COLD_COMPACTION:
+      return std::unique_ptr<DefragStrategy>(new CompactionStrategy(CompactionPlanner::Layout::HOT_COLD));
+    default:
+      return std::unique_ptr<DefragStrategy>(new FirstFitStrategy());
+  }
+}
+
+// Get whether a strategy leaves all data packed at the beginning
+bool DefragStrategy::compactsFreeSpace(DefragStrategyType type) {
+  switch (type) {
+    case DefragStrategyType::SLIDING_COMPACTION:
+    case DefragStrategyType::WHOLE_DISK_COMPACTION:
+    case DefragStrategyType::HOT_COLD_COMPACTION:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Choose the next file to move (the first unoptimized block in disk order)
+bool FileByFileStrategy::selectFile(GridManager&, FileManager& fileManager, PlannedMove& move) {
+  BlockState fileType = BlockState::FREE;
+  fileManager.findNextFileToMove(move.fileID, fileType, move.fileBlocks);
+  return move.fileID >= 0 && !move.fileBlocks.empty();
+}
+
+// Choose the destination of the file (the first free run that fits)
+bool FileByFileStrategy::findTarget(GridManager&, FileManager& fileManager, PlannedMove& move) {
+  return fileManager.findTargetPositionsForFile(move.fileBlocks, move.targetPositions);
+}
+
+// Plan the next move and apply its result to the grid
+bool FileByFileStrategy::planNextMove(GridManager& gridManager, FileManager& fileManager, PlannedMove& move) {
+  move.fileBlocks.clear();
+  move.targetPositions.clear();
+  if (!selectFile(gridManager, fileManager, move)) {
+    return false;
+  }
+
+  // Without room the file is optimized where it is
+  if (!findTarget(gridManager, fileManager, move)) {
+    move.targetPositions.clear();
+  }
+  fileManager.completePlannedMove(move);
+  return true;
+}
+
+// Get the name of the strategy
+const char* FirstFitStrategy::getName() const {
+  return "first-fit";
+}
+
+// Choose the smallest free run that fits the file
+bool BestFitStrategy::findTarget(GridManager& gridManager, FileManager&, PlannedMove& move) {
+  const int columnCount = gridManager.getColumnCount();
+  const int cellCount = columnCount * gridManager.getRowCount();
+  const int fileSize = move.fileBlocks.size();
+  int bestStart = -1;
+  int bestLength = 0;
+
+  // Free runs in disk order (a run continues on the next row, like first-fit)
+  int runStart = -1;
+  for (int cell = 0; cell <= cellCount; cell++) {
+    bool isFree = cell < cellCount &&
+                  gridManager.getBlock(cell % columnCount, cell / columnCount).state == BlockState::FREE;
+    if (isFree) {
+      if (runStart < 0) {
+        runStart = cell;
+      }
+      continue;
+    }
+
+    // End of a run: keep it if it is the tightest fit so far
+    int runLength = (runStart < 0) ? 0 : cell - runStart;
+    if (runLength >= fileSize && (bestStart < 0 || runLength < bestLength)) {
+      bestStart = runStart;
+      bestLength = runLength;
+    }
+    runStart = -1;
+  }
+  if (bestStart < 0) {
+    return false;
+  }
+
+  move.targetPositions.clear();
+  for (int i = 0; i < fileSize; i++) {
+    move.targetPositions.push_back(std::make_pair((bestStart + i) % columnCount, (bestStart + i) / columnCount));
+  }
+  return true;
+}
+
+// Get the name of the strategy
+const char* BestFitStrategy::getName() const {
+  return "best-fit";
+}
+
+// Choose the file with the most blocks
+bool LargestFileFirstStrategy::selectFile(GridManager&, FileManager& fileManager, PlannedMove& move) {
+  std::vector<PlannedMove> files;
+  fileManager.collectUnoptimizedFiles(files);
+
+  const PlannedMove* largest = nullptr;
+  for (const auto &file : files) {
+    if (largest == nullptr || file.fileBlocks.size() > largest->fileBlocks.size()) {
+      largest = &file;
+    }
+  }
+  if (largest == nullptr) {
+    return false;
+  }
+  move = *largest;
+  return true;
+}
+
+// Get the name of the strategy
+const char* LargestFileFirstStrategy::getName() const {
+  return "largest-file-first";
+}
+
+// Choose the file split into the most fragments
+bool MostFragmentedFirstStrategy::selectFile(GridManager& gridManager, FileManager& fileManager, PlannedMove& move) {
+  const int columnCount = gridManager.getColumnCount();
+  std::vector<PlannedMove> files;
+  fileManager.collectUnoptimizedFiles(files);
+
+  const PlannedMove* mostFragmented = nullptr;
+  int mostFragments = 0;
+  for (const auto &file : files) {
+    // A new fragment starts wherever a block does not directly follow the previous one in disk order
+    int fragments = 1;
+    for (size_t i = 1; i < file.fileBlocks.size(); i++) {
+      int previous = file.fileBlocks[i - 1].second * columnCount + file.fileBlocks[i - 1].first;
+      int current = file.fileBlocks[i].second * columnCount + file.fileBlocks[i].first;
+      if (current != previous + 1) {
+        fragments++;
+      }
+    }
+    if (mostFragmented == nullptr || fragments > mostFragments) {
+      mostFragmented = &file;
+      mostFragments = fragments;
+    }
+  }
+  if (mostFragmented == nullptr) {
+    return false;
+  }
+  move = *mostFragmented;
+  return true;
+}
+
+// Get the name of the strategy
+const char* MostFragmentedFirstStrategy::getName() const {
+  return "most-fragmented-first";
+}
+
+// Constructor
+CompactionStrategy::CompactionStrategy(CompactionPlanner::Layout layout)
+  : layout(layout),
+    nextMove(0),
+    plannedMoveCount(-1),
+    plannedBlockCount(-1) {
+}
+
+// Get the name of the strategy
+const char* CompactionStrategy::getName() const {
+  switch (layout) {
+    case CompactionPlanner::Layout::SLIDING:
+      return "sliding-compaction";
+    case CompactionPlanner::Layout::HOT_COLD:
+      return "hot-cold-compaction";
+    default:
+      return "whole-disk-compaction";
+  }
+}
+
+// Plan all moves
+void CompactionStrategy::begin(GridManager& gridManager, FileManager& fileManager) {
+  CompactionPlanner compactionPlanner(gridManager, fileManager, layout);
+  compactionPlanner.plan(plan);
+  nextMove = 0;
+
+  // Moves without targets only optimize files in place
+  plannedMoveCount = 0;
+  plannedBlockCount = 0;
+  for (const auto &move : plan) {
+    if (!move.targetPositions.empty()) {
+      plannedMoveCount++;
+      plannedBlockCount += move.targetPositions.size();
+    }
+  }
+}
+
+// Hand out the next planned move
+bool CompactionStrategy::planNextMove(GridManager&, FileManager&, PlannedMove& move) {
+  if (nextMove >= plan.size()) {
+    return false;
+  }
+  move = plan[nextMove++];
+  return true;
+}
+
+// Get the number of moves planned by begin
+int CompactionStrategy::getPlannedMoveCount() const {
+  return plannedMoveCount;
+}
+
+// Get the number of blocks moved by the moves planned by begin
+int CompactionStrategy::getPlannedBlockCount() const {
+  return plannedBlockCount;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file DiskModel.cpp
+ * @brief Implementation of timing models of the simulated drive
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file implements the DiskModel interface and the spinning disk and
+ * solid-state models charging the block reads and writes.
+ */
+
+#include "DiskModel.h"
+#include <cmath>
+
+// Constructor
+DiskModel::DiskModel(int cellCount)
+  : elapsedTime(0),
+    transferredBytes(0),
+    cellCount(cellCount),
+    busyUntil(0) {
+}
+
+// Reset
+void DiskModel::reset(int cellCount) {
+  elapsedTime = 0;
+  transferredBytes = 0;
+  this->cellCount = cellCount;
+  busyUntil = 0;
+}
+
+// Get the number of clusters of the drive
+int DiskModel::getCellCount() const {
+  return cellCount;
+}
+
+// Charge a block read or write
+uint32_t DiskModel::access(int cell, bool isWrite, uint64_t issueTime) {
+  uint64_t startTime = (issueTime > busyUntil) ? issueTime : busyUntil;
+  uint32_t duration = serviceRequest(cell, isWrite, startTime);
+  busyUntil = startTime + duration;
+  elapsedTime += duration;
+  transferredBytes += Config::Disk::BLOCK_BYTES;
+  return duration;
+}
+
+// Get the time spent servicing requests
+uint64_t DiskModel::getElapsedTime() const {
+  return elapsedTime;
+}
+
+// Get the bytes read and written
+uint64_t DiskModel::getTransferredBytes() const {
+  return transferredBytes;
+}
+
+// Get the average throughput so far
+uint64_t DiskModel::getThroughput() const {
+  if (elapsedTime == 0) {
+    return 0;
+  }
+  return transferredBytes * 1000000 / elapsedTime;
+}
+
+// Estimate the time to copy blocks at the throughput so far
+uint64_t DiskModel::estimateCopyTime(int blockCount) const {
+  if (transferredBytes == 0) {
+    return 0;
+  }
+  // Every block is read once and written once
+  uint64_t remainingBytes = (uint64_t)blockCount * 2 * Config::Disk::BLOCK_BYTES;
+  return remainingBytes * elapsedTime / transferredBytes;
+}
+
+// Create a model
+std::unique_ptr<DiskModel> DiskModel::create(DiskModelType type, int cellCount) {
+  switch (type) {
+    case DiskModelType::SSD:
+      return std::unique_ptr<DiskModel>(new SsdModel(cellCount));
+    default:
+      return std::unique_ptr<DiskModel>(new HddModel(cellCount));
+  }
+}
+
+// Constructor
+HddModel::HddModel(int cellCount)
+  : DiskModel(cellCount),
+    headCylinder(0) {
+}
+
+// Get the name of the model
+const char* HddModel::getName() const {
+  return "hdd";
+}
+
+// Reset
+void HddModel::reset(int cellCount) {
+  DiskModel::reset(cellCount);
+  headCylinder = 0;
+}
+
+// Get the seek time across a number of cylinders
+uint32_t HddModel::getSeekTime(int distance, int cylinderCount) const {
+  if (distance == 0) {
+    return 0;
+  }
+  if (cylinderCount <= 2) {
+    return Config::Disk::Hdd::TRACK_TO_TRACK_SEEK;
+  }
+
+  // Short seeks are dominated by the acceleration of the arm, so the time grows with the square root of the distance
+  double fraction = std::sqrt((double)(distance - 1) / (cylinderCount - 2));
+  return Config::Disk::Hdd::TRACK_TO_TRACK_SEEK +
+         (uint32_t)((Config::Disk::Hdd::FULL_STROKE_SEEK - Config::Disk::Hdd::TRACK_TO_TRACK_SEEK) * fraction);
+}
+
+// Get the time a block read or write takes
+uint32_t HddModel::serviceRequest(int cell, bool isWrite, uint64_t startTime) {
+  const int blocksPerTrack = Config::Disk::Hdd::BLOCKS_PER_TRACK;
+  const uint32_t blockTime = 60000000 / (Config::Disk::Hdd::RPM * blocksPerTrack);  // Time a block takes to pass under the head
+  const uint32_t revolutionTime = blockTime * blocksPerTrack;
+  int cylinderCount = (getCellCount() + blocksPerTrack - 1) / blocksPerTrack;
+  int cylinder = cell / blocksPerTrack;
+
+  // Seek to the cylinder of the block
+  int distance = (cylinder > headCylinder) ? cylinder - headCylinder : headCylinder - cylinder;
+  uint32_t seekTime = getSeekTime(distance, cylinderCount);
+  headCylinder = cylinder;
+
+  // A write waits for the head to settle on the track more precisely than a read
+  if (isWrite && distance > 0) {
+    seekTime += Config::Disk::Hdd::WRITE_SETTLE_TIME;
+  }
+
+  // Wait for the block to come under the head
+  // (each track starts later by the blocks passing during a track-to-track seek, so a sequential run crossing tracks does not wait a revolution)
+  int trackSkew = (Config::Disk::Hdd::TRACK_TO_TRACK_SEEK + blockTime - 1) / blockTime;
+  uint32_t blockAngle = ((cell % blocksPerTrack + cylinder * trackSkew) % blocksPerTrack) * blockTime;
+  uint32_t platterAngle = (startTime + seekTime) % revolutionTime;
+  uint32_t rotationalLatency = (blockAngle + revolutionTime - platterAngle) % revolutionTime;
+
+  return seekTime + rotationalLatency + blockTime;
+}
+
+// Constructor
+SsdModel::SsdModel(int cellCount)
+  : DiskModel(cellCount),
+    lastCell(-1),
+    lastWasWrite(false) {
+}
+
+// Get the name of the model
+const char* SsdModel::getName() const {
+  return "ssd";
+}
+
+// Reset
+void SsdModel::reset(int cellCount) {
+  DiskModel::reset(cellCount);
+  lastCell = -1;
+  lastWasWrite = false;
+}
+
+// Get the time a block read or write takes
+uint32_t SsdModel::serviceRequest(int cell, bool isWrite, uint64_t) {
+  // Bytes per microsecond equal MB/s
+  uint32_t duration = Config::Disk::BLOCK_BYTES / Config::Disk::Ssd::TRANSFER_RATE;
+  if (lastCell < 0 || cell != lastCell + 1 || isWrite != lastWasWrite) {
+    duration += Config::Disk::Ssd::ACCESS_LATENCY;
+  }
+  lastCell = cell;
+  lastWasWrite = isWrite;
+  return duration;
+}
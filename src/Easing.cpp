@@ -0,0 +1,38 @@
+/**
+ * @file Easing.cpp
+ * @brief Implementation of integer easing curves for block movements
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the Easing class. The ease-out table is computed once
+ * with integer arithmetic only, so it is identical on every platform.
+ */
+
+#include "Easing.h"
+
+// Ease-out table (progress after each tick, Q16.16)
+struct EaseOutTable {
+  fixed_t progress[Config::Animation::EASING_TICKS + 1];
+
+  // Constructor (each tick covers MOVE_SPEED of the remaining distance)
+  EaseOutTable() {
+    fixed_t remaining = FixedPoint::ONE;
+    for (int tick = 0; tick < Config::Animation::EASING_TICKS; tick++) {
+      progress[tick] = FixedPoint::ONE - remaining;
+      remaining -= FixedPoint::multiply(remaining, Config::Animation::MOVE_SPEED);
+    }
+    // The last entry always lands exactly on the target
+    progress[Config::Animation::EASING_TICKS] = FixedPoint::ONE;
+  }
+};
+
+static const EaseOutTable easeOutTable;
+
+// Get the progress of an ease-out movement after the given number of ticks
+fixed_t Easing::easeOut(int tick) {
+  if (tick >= Config::Animation::EASING_TICKS) {
+    return FixedPoint::ONE;
+  }
+  return easeOutTable.progress[tick];
+}
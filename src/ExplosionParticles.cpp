@@ -0,0 +1,167 @@
+/**
+ * @file ExplosionParticles.cpp
+ * @brief Implementation of particle system for the touch explosion animation
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the ExplosionParticles class which animates the debris
+ * of exploded blocks. Positions and velocities are kept in packed arrays
+ * (structure of arrays) of Q16.16 fixed-point numbers so the integrate step
+ * is a set of simple integer loops, and particles that can no longer return
+ * to the screen are culled.
+ */
+
+#include "ExplosionParticles.h"
+#include "Block.h"
+
+// Calculate the velocity pushing a block at the given screen position away from the touch point
+void ExplosionParticles::calculateVelocity(fixed_t screenX, fixed_t screenY, int touchX, int touchY,
+                                           fixed_t& velocityX, fixed_t& velocityY) {
+  // Calculate the direction vector from the touch coordinates (screen coordinate system)
+  fixed_t dirX = screenX - FixedPoint::fromInt(touchX);
+  fixed_t dirY = screenY - FixedPoint::fromInt(touchY);
+
+  // Calculate distance (add a small value to prevent division by zero)
+  fixed_t distance = FixedPoint::length(dirX, dirY) + FixedPoint::fromFloat(0.1f);
+
+  // Normalize the direction vector and set the velocity
+  // Adjust so that the closer to the center, the greater the velocity
+  fixed_t speed = FixedPoint::ONE + FixedPoint::divide(FixedPoint::fromInt(30), distance);
+  velocityX = FixedPoint::multiply(FixedPoint::divide(dirX, distance), speed);
+  velocityY = FixedPoint::multiply(FixedPoint::divide(dirY, distance), speed);
+}
+
+// Remove all particles
+void ExplosionParticles::clear() {
+  posX.clear();
+  posY.clear();
+  prevPosX.clear();
+  prevPosY.clear();
+  velX.clear();
+  velY.clear();
+}
+
+// Add the debris of the block at grid cell (cellX, cellY), currently drawn at (x, y)
+void ExplosionParticles::spawn(int cellX, int cellY, fixed_t x, fixed_t y, int touchX, int touchY) {
+  // The direction is taken from the center of the block's cell (once per block, at spawn only)
+  fixed_t screenX = FixedPoint::fromInt(Config::getGridOffsetX() + cellX * (Config::getBlockWidth() + 2) + Config::getBlockWidth() / 2);
+  fixed_t screenY = FixedPoint::fromInt(Config::getGridOffsetY() + cellY * (Config::getBlockHeight() + 2) + Config::getBlockHeight() / 2);
+
+  fixed_t velocityX, velocityY;
+  calculateVelocity(screenX, screenY, touchX, touchY, velocityX, velocityY);
+
+  posX.push_back(x);
+  posY.push_back(y);
+  prevPosX.push_back(x);
+  prevPosY.push_back(y);
+  velX.push_back(velocityX);
+  velY.push_back(velocityY);
+}
+
+// Push all particles away from a new touch point
+void ExplosionParticles::kick(int touchX, int touchY) {
+  for (size_t i = 0; i < posX.size(); i++) {
+    fixed_t screenX = FixedPoint::fromInt(Config::getGridOffsetX() + Config::getBlockWidth() / 2) +
+                      posX[i] * (Config::getBlockWidth() + 2);
+    fixed_t screenY = FixedPoint::fromInt(Config::getGridOffsetY() + Config::getBlockHeight() / 2) +
+                      posY[i] * (Config::getBlockHeight() + 2);
+    calculateVelocity(screenX, screenY, touchX, touchY, velX[i], velY[i]);
+  }
+}
+
+// Advance all particles by one tick
+void ExplosionParticles::update() {
+  // Remember the positions at the previous tick for interpolation
+  prevPosX = posX;
+  prevPosY = posY;
+  
+  const size_t count = posX.size();
+  fixed_t* px = posX.data();
+  fixed_t* py = posY.data();
+  const fixed_t* vx = velX.data();
+  fixed_t* vy = velY.data();
+
+  // Apply gravity in the Y-axis direction (increase velocity)
+  for (size_t i = 0; i < count; i++) {
+    vy[i] += Config::Animation::GRAVITY;
+  }
+
+  // Update positions
+  for (size_t i = 0; i < count; i++) {
+    px[i] += vx[i];
+  }
+  for (size_t i = 0; i < count; i++) {
+    py[i] += vy[i];
+  }
+
+  cull();
+}
+
+// Remove particles that have left the screen for good (keeps drawing order)
+void ExplosionParticles::cull() {
+  // Screen bounds in grid units
+  const fixed_t cellWidth = FixedPoint::fromInt(Config::getBlockWidth() + 2);
+  const fixed_t cellHeight = FixedPoint::fromInt(Config::getBlockHeight() + 2);
+  const fixed_t minX = FixedPoint::divide(FixedPoint::fromInt(-Config::getBlockWidth() - Config::getGridOffsetX()), cellWidth);
+  const fixed_t maxX = FixedPoint::divide(FixedPoint::fromInt(Config::getScreenWidth() - Config::getGridOffsetX()), cellWidth);
+  const fixed_t maxY = FixedPoint::divide(FixedPoint::fromInt(Config::getScreenHeight() - Config::getGridOffsetY()), cellHeight);
+  // Debris thrown more than a screen height above the top would take seconds to fall back
+  // (and could leave the Q16.16 range), so it is treated as gone
+  const fixed_t minY = FixedPoint::divide(FixedPoint::fromInt(-Config::getScreenHeight() - Config::getGridOffsetY()), cellHeight);
+
+  size_t kept = 0;
+  for (size_t i = 0; i < posX.size(); i++) {
+    // Horizontal velocity is constant and gravity only pulls down,
+    // so particles past the sides or the bottom moving outward never come back
+    bool gone = (posX[i] <= minX && velX[i] <= 0) ||
+                (posX[i] >= maxX && velX[i] >= 0) ||
+                (posY[i] >= maxY && velY[i] >= 0) ||
+                posY[i] <= minY;
+    if (!gone) {
+      posX[kept] = posX[i];
+      posY[kept] = posY[i];
+      prevPosX[kept] = prevPosX[i];
+      prevPosY[kept] = prevPosY[i];
+      velX[kept] = velX[i];
+      velY[kept] = velY[i];
+      kept++;
+    }
+  }
+
+  posX.resize(kept);
+  posY.resize(kept);
+  prevPosX.resize(kept);
+  prevPosY.resize(kept);
+  velX.resize(kept);
+  velY.resize(kept);
+}
+
+// Get whether all particles have left the screen
+bool ExplosionParticles::isEmpty() const {
+  return posX.empty();
+}
+
+// Get the number of live particles
+int ExplosionParticles::getCount() const {
+  return posX.size();
+}
+
+// Draw all particles
+void ExplosionParticles::draw(RenderTarget& target, float alpha) const {
+  for (size_t i = 0; i < posX.size(); i++) {
+    // Interpolate between the previous and the current tick
+    float x = FixedPoint::toFloat(prevPosX[i]) + FixedPoint::toFloat(posX[i] - prevPosX[i]) * alpha;
+    float y = FixedPoint::toFloat(prevPosY[i]) + FixedPoint::toFloat(posY[i] - prevPosY[i]) * alpha;
+    
+    int screenX = Config::getGridOffsetX() + x * (Config::getBlockWidth() + 2);
+    int screenY = Config::getGridOffsetY() + y * (Config::getBlockHeight() + 2);
+
+    // Skip particles outside the band being rendered
+    if (!target.isVisible(screenX, screenY, Config::getBlockWidth(), Config::getBlockHeight())) {
+      continue;
+    }
+
+    Block::drawBadBlock(target, screenX, screenY);
+  }
+}
@@ -9,6 +9,7 @@
  * grouping, and movement operations during the defragmentation process.
  */
 
+#include <map>
 #include "FileManager.h"
 #include "PlatformCompat.h"
 
@@ -58,6 +59,20 @@ void FileManager::assignFileIDs() {
       previousFileID = block.fileID;
     }
   }
+  
+  // Blocks already optimized are files of their own (IDs after the random range),
+  // so they do not count as fragments of the files sharing their random ID
+  for (int y = 0; y < gridManager.getRowCount(); y++) {
+    for (int x = 0; x < gridManager.getColumnCount(); x++) {
+      Block& block = gridManager.getBlock(x, y);
+      if (block.state == BlockState::INVISIBLE_OPTIMIZED) {
+        block.fileID = fileIdDist.max() + 1 + y * gridManager.getColumnCount() + x;
+      }
+    }
+  }
+  
+  // The metrics follow each block change from here on
+  gridManager.rebuildFragmentationMetrics();
 }
 
 // Find file to move
@@ -105,6 +120,33 @@ void FileManager::collectFileBlocks(int fileID, std::vector<std::pair<int, int>>
   }
 }
 
+// Collect all unoptimized files that are not moving
+void FileManager::collectUnoptimizedFiles(std::vector<PlannedMove> &files) {
+  files.clear();
+  std::map<int, size_t> fileIndexes;  // Index in files of each file ID
+  
+  for (int y = 0; y < gridManager.getRowCount(); y++) {
+    for (int x = 0; x < gridManager.getColumnCount(); x++) {
+      Block& block = gridManager.getBlock(x, y);
+      if ((block.state != BlockState::UNOPT_BEGIN && 
+           block.state != BlockState::UNOPT_MIDDLE && 
+           block.state != BlockState::UNOPT_END) || 
+          block.fileID < 0 || 
+          block.isMoving) {
+        continue;
+      }
+      
+      // Start a new file at its first block
+      if (fileIndexes.count(block.fileID) == 0) {
+        fileIndexes[block.fileID] = files.size();
+        files.push_back(PlannedMove());
+        files.back().fileID = block.fileID;
+      }
+      files[fileIndexes[block.fileID]].fileBlocks.push_back(std::make_pair(x, y));
+    }
+  }
+}
+
 // Find target positions for a file
 bool FileManager::findTargetPositionsForFile(const std::vector<std::pair<int, int>> &fileBlocks,
                                 std::vector<std::pair<int, int>> &targetPositions) {
@@ -159,7 +201,16 @@ bool FileManager::findTargetPositionsForFile(const std::vector<std::pair<int, in
 // Move file to target
 void FileManager::moveFileToTarget(const std::vector<std::pair<int, int>> &fileBlocks,
                       const std::vector<std::pair<int, int>> &targetPositions,
-                      int fileID) {
+                      int fileID, uint64_t startTime) {
+  // Change the state of the source blocks to reading first
+  // (a batch of several files may write into cells that another of its files is leaving)
+  std::vector<int> fileIDs;
+  for (size_t i = 0; i < fileBlocks.size(); i++) {
+    Block& sourceBlock = gridManager.getBlock(fileBlocks[i].first, fileBlocks[i].second);
+    fileIDs.push_back(sourceBlock.fileID);
+    gridManager.setBlockState(fileBlocks[i].first, fileBlocks[i].second, BlockState::READING);
+  }
+  
   // Move each block in the file
   for (size_t i = 0; i < fileBlocks.size(); i++) {
     int sourceX = fileBlocks[i].first;
@@ -167,26 +218,16 @@ void FileManager::moveFileToTarget(const std::vector<std::pair<int, int>> &fileB
     int targetX = targetPositions[i].first;
     int targetY = targetPositions[i].second;
     
-    // Change the state of the source block to reading
-    Block& sourceBlock = gridManager.getBlock(sourceX, sourceY);
-    BlockState originalState = sourceBlock.state;
-    sourceBlock.state = BlockState::READING;
-    
     // Set the target block
     Block& targetBlock = gridManager.getBlock(targetX, targetY);
     
     // Set the target block to writing state
-    targetBlock.state = BlockState::WRITING;
-    targetBlock.fileID = sourceBlock.fileID;
+    gridManager.setBlockState(targetX, targetY, BlockState::WRITING, fileIDs[i]);
     
     // Start movement animation (from source to target)
-    targetBlock.startMoving(targetX, targetY);
-    // Set animation start position to source
-    targetBlock.animX = sourceX;
-    targetBlock.animY = sourceY;
-    
-    // Add a slight delay when moving each block to prevent sounds from overlapping
-    delay(Config::Animation::BLOCK_MOVE_DELAY);
+    // Each block leaves a little after the previous one (the animation update launches it)
+    targetBlock.startMoving(sourceX, sourceY, targetX, targetY,
+                            startTime + (uint64_t)i * Config::Animation::BLOCK_MOVE_DELAY * 1000);
   }
   
   // Set file moving flag
@@ -217,38 +258,85 @@ void FileManager::updateFileMovement() {
 }
 
 // Move next file
-void FileManager::moveNextFile() {
-  // Use GridManager's random number generator
-  std::mt19937& rng = gridManager.getRNG();
-  
+void FileManager::moveNextFile(uint64_t now) {
+  PlannedMove move;
+  if (planNextMove(move)) {
+    applyPlannedMove(move, now);
+  }
+}
+
+// Decide the next file move without changing the grid
+bool FileManager::planNextMove(PlannedMove &move) {
   // Find unoptimized files
   int fileToMove = -1;
   BlockState fileType = BlockState::FREE;
-  std::vector<std::pair<int, int>> fileBlocks; // Coordinates of blocks belonging to the file
   
-  findNextFileToMove(fileToMove, fileType, fileBlocks);
+  findNextFileToMove(fileToMove, fileType, move.fileBlocks);
   
-  if (fileToMove < 0 || fileBlocks.empty()) {
+  if (fileToMove < 0 || move.fileBlocks.empty()) {
     // If there are no unoptimized files, complete
-    return;
+    return false;
   }
+  move.fileID = fileToMove;
   
   // Determine the target
-  std::vector<std::pair<int, int>> bestTargetPositions;
-  bool foundTarget = findTargetPositionsForFile(fileBlocks, bestTargetPositions);
-  
+  if (!findTargetPositionsForFile(move.fileBlocks, move.targetPositions)) {
+    move.targetPositions.clear();
+  }
+  return true;
+}
+
+// Start a planned move
+void FileManager::applyPlannedMove(const PlannedMove &move, uint64_t startTime) {
   // If a target is found, execute the move process
-  if (foundTarget && !bestTargetPositions.empty()) {      
-    moveFileToTarget(fileBlocks, bestTargetPositions, fileToMove);
+  if (!move.targetPositions.empty()) {
+    moveFileToTarget(move.fileBlocks, move.targetPositions, move.fileID, startTime);
   } else {
     // If no target is found, this file will not be moved
     // Change blocks in the file to optimized (blue)
-    for (auto &pos : fileBlocks) {
-      gridManager.getBlock(pos.first, pos.second).state = BlockState::OPTIMIZED;
+    for (auto &pos : move.fileBlocks) {
+      gridManager.setBlockState(pos.first, pos.second, BlockState::OPTIMIZED);
     }
   }
 }
 
+// Change the grid to the state after a planned move has finished
+void FileManager::completePlannedMove(const PlannedMove &move) {
+  if (move.targetPositions.empty()) {
+    applyPlannedMove(move, 0);
+    return;
+  }
+  
+  // Source blocks become free space, target blocks optimized data of the file
+  // (the same result as AnimationManager::processCompletedBlocks; a file shifting
+  // over its own blocks frees them all before writing any)
+  std::vector<int> fileIDs;
+  for (const auto &source : move.fileBlocks) {
+    fileIDs.push_back(gridManager.getBlock(source.first, source.second).fileID);
+    gridManager.setBlockState(source.first, source.second, BlockState::FREE, -1);
+  }
+  for (size_t i = 0; i < move.targetPositions.size(); i++) {
+    const std::pair<int, int> &target = move.targetPositions[i];
+    gridManager.setBlockState(target.first, target.second, BlockState::OPTIMIZED, fileIDs[i]);
+  }
+}
+
+// Count the blocks of a started move that have not reached their targets yet
+int FileManager::countBlocksInFlight(const PlannedMove &move) const {
+  int count = 0;
+  for (auto &pos : move.targetPositions) {
+    if (gridManager.getBlock(pos.first, pos.second).isMoving) {
+      count++;
+    }
+  }
+  return count;
+}
+
+// Get whether all blocks of a started move have reached their targets
+bool FileManager::isMoveFinished(const PlannedMove &move) const {
+  return countBlocksInFlight(move) == 0;
+}
+
 // Get whether moving
 bool FileManager::isMoving() const {
   return isMovingFile;
@@ -263,3 +351,17 @@ int FileManager::getCurrentFileToMove() const {
 int FileManager::getNextFileID() const {
   return nextFileID;
 }
+
+// Get the access heat of a file
+int FileManager::getAccessHeat(int fileID) {
+  // Scramble the ID (integer hash) so neighbouring IDs land on unrelated levels
+  uint32_t hash = (uint32_t)fileID;
+  hash = ((hash >> 16) ^ hash) * 0x45d9f3bu;
+  hash = ((hash >> 16) ^ hash) * 0x45d9f3bu;
+  hash = (hash >> 16) ^ hash;
+  
+  // Level n of the Zipf distribution is accessed 1/n as often as the hottest one
+  int level = hash % Config::Placement::HEAT_LEVELS;
+  int heat = Config::Placement::MAX_ACCESS_HEAT / (level + 1);
+  return (heat > 0) ? heat : 1;
+}
@@ -0,0 +1,234 @@
+/**
+ * @file FragmentationMetrics.cpp
+ * @brief Implementation of incremental fragmentation analysis
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file implements the FragmentationMetrics class. A block joining a
+ * file adds a fragment unless it touches blocks of that file on either side,
+ * and a free block merges the free extents next to it; removing a block
+ * undoes the same. Free extents are kept by their first cell with a sorted
+ * list of their lengths, so the largest is known without a scan.
+ */
+
+#include <iterator>
+#include "FragmentationMetrics.h"
+
+// Constructor
+FragmentationSummary::FragmentationSummary()
+  : fileCount(0),
+    fragmentedFileCount(0),
+    fragmentCount(0),
+    fileBlockCount(0),
+    freeBlockCount(0),
+    freeExtentCount(0),
+    largestFreeExtent(0) {
+}
+
+// Get the average number of fragments per file
+float FragmentationSummary::getFragmentsPerFile() const {
+  return (fileCount > 0) ? (float)fragmentCount / fileCount : 0.0f;
+}
+
+// Get the share of files split into more than one fragment
+int FragmentationSummary::getFragmentedFilePercentage() const {
+  return (fileCount > 0) ? fragmentedFileCount * 100 / fileCount : 0;
+}
+
+// Get the average fragment size
+float FragmentationSummary::getAverageFragmentSize() const {
+  return (fragmentCount > 0) ? (float)fileBlockCount / fragmentCount : 0.0f;
+}
+
+// Get the share of free blocks outside the largest free extent
+int FragmentationSummary::getFreeSpaceFragmentation() const {
+  return (freeBlockCount > 0) ? (freeBlockCount - largestFreeExtent) * 100 / freeBlockCount : 0;
+}
+
+// Get whether two summaries hold the same metrics
+bool FragmentationSummary::operator==(const FragmentationSummary& other) const {
+  return fileCount == other.fileCount &&
+         fragmentedFileCount == other.fragmentedFileCount &&
+         fragmentCount == other.fragmentCount &&
+         fileBlockCount == other.fileBlockCount &&
+         freeBlockCount == other.freeBlockCount &&
+         freeExtentCount == other.freeExtentCount &&
+         largestFreeExtent == other.largestFreeExtent;
+}
+
+bool FragmentationSummary::operator!=(const FragmentationSummary& other) const {
+  return !(*this == other);
+}
+
+// Constructor
+FragmentationMetrics::FragmentationMetrics() {
+}
+
+// Reset to a drive of cellCount cells that are neither free nor data
+void FragmentationMetrics::reset(int cellCount) {
+  cellFiles.assign(cellCount, -1);
+  freeCells.assign(cellCount, false);
+  files.clear();
+  freeExtents.clear();
+  freeExtentLengths.clear();
+  summary = FragmentationSummary();
+}
+
+// Apply the change of a cell to a block state
+void FragmentationMetrics::update(int cell, BlockState state, int fileID) {
+  int newFile = isFileState(state) ? fileID : -1;
+  if (cellFiles[cell] != newFile) {
+    if (cellFiles[cell] >= 0) {
+      removeFileBlock(cell);
+    }
+    if (newFile >= 0) {
+      addFileBlock(cell, newFile);
+    }
+  }
+
+  bool isFree = isFreeState(state);
+  if (freeCells[cell] != isFree) {
+    if (isFree) {
+      addFreeCell(cell);
+    } else {
+      removeFreeCell(cell);
+    }
+  }
+}
+
+// Add a cell to the data of a file
+void FragmentationMetrics::addFileBlock(int cell, int fileID) {
+  bool joinsPrevious = cell > 0 && cellFiles[cell - 1] == fileID;
+  bool joinsNext = cell + 1 < (int)cellFiles.size() && cellFiles[cell + 1] == fileID;
+  cellFiles[cell] = fileID;
+
+  std::map<int, FileStats>::iterator file = files.find(fileID);
+  if (file == files.end()) {
+    FileStats stats = {0, 0};
+    file = files.insert(std::make_pair(fileID, stats)).first;
+    summary.fileCount++;
+  }
+
+  // A lone block is a new fragment, a block between two fragments joins them
+  int fragmentChange = 1 - (joinsPrevious ? 1 : 0) - (joinsNext ? 1 : 0);
+  bool wasFragmented = file->second.fragmentCount > 1;
+  file->second.blockCount++;
+  file->second.fragmentCount += fragmentChange;
+  summary.fileBlockCount++;
+  summary.fragmentCount += fragmentChange;
+  if (wasFragmented != (file->second.fragmentCount > 1)) {
+    summary.fragmentedFileCount += wasFragmented ? -1 : 1;
+  }
+}
+
+// Remove a cell from the data of its file
+void FragmentationMetrics::removeFileBlock(int cell) {
+  int fileID = cellFiles[cell];
+  cellFiles[cell] = -1;
+  bool joinsPrevious = cell > 0 && cellFiles[cell - 1] == fileID;
+  bool joinsNext = cell + 1 < (int)cellFiles.size() && cellFiles[cell + 1] == fileID;
+
+  std::map<int, FileStats>::iterator file = files.find(fileID);
+  int fragmentChange = (joinsPrevious ? 1 : 0) + (joinsNext ? 1 : 0) - 1;
+  bool wasFragmented = file->second.fragmentCount > 1;
+  file->second.blockCount--;
+  file->second.fragmentCount += fragmentChange;
+  summary.fileBlockCount--;
+  summary.fragmentCount += fragmentChange;
+  if (wasFragmented != (file->second.fragmentCount > 1)) {
+    summary.fragmentedFileCount += wasFragmented ? -1 : 1;
+  }
+
+  if (file->second.blockCount == 0) {
+    files.erase(file);
+    summary.fileCount--;
+  }
+}
+
+// Add a free cell
+void FragmentationMetrics::addFreeCell(int cell) {
+  freeCells[cell] = true;
+  summary.freeBlockCount++;
+  int firstCell = cell;
+  int length = 1;
+
+  // Merge with the extent ending just before the cell
+  if (cell > 0 && freeCells[cell - 1]) {
+    std::map<int, int>::iterator previous = std::prev(freeExtents.upper_bound(cell));
+    firstCell = previous->first;
+    length += previous->second;
+    eraseFreeExtent(previous);
+  }
+
+  // Merge with the extent starting just after the cell
+  if (cell + 1 < (int)freeCells.size() && freeCells[cell + 1]) {
+    std::map<int, int>::iterator next = freeExtents.find(cell + 1);
+    length += next->second;
+    eraseFreeExtent(next);
+  }
+
+  insertFreeExtent(firstCell, length);
+}
+
+// Remove a free cell
+void FragmentationMetrics::removeFreeCell(int cell) {
+  std::map<int, int>::iterator extent = std::prev(freeExtents.upper_bound(cell));
+  int firstCell = extent->first;
+  int lastCell = extent->first + extent->second - 1;
+  eraseFreeExtent(extent);
+  freeCells[cell] = false;
+  summary.freeBlockCount--;
+
+  // The cells on either side stay free
+  if (cell > firstCell) {
+    insertFreeExtent(firstCell, cell - firstCell);
+  }
+  if (cell < lastCell) {
+    insertFreeExtent(cell + 1, lastCell - cell);
+  }
+}
+
+// Record a free extent
+void FragmentationMetrics::insertFreeExtent(int firstCell, int length) {
+  freeExtents[firstCell] = length;
+  freeExtentLengths.insert(length);
+  summary.freeExtentCount = freeExtents.size();
+  summary.largestFreeExtent = *freeExtentLengths.rbegin();
+}
+
+// Forget a free extent
+void FragmentationMetrics::eraseFreeExtent(std::map<int, int>::iterator extent) {
+  freeExtentLengths.erase(freeExtentLengths.find(extent->second));
+  freeExtents.erase(extent);
+  summary.freeExtentCount = freeExtents.size();
+  summary.largestFreeExtent = freeExtentLengths.empty() ? 0 : *freeExtentLengths.rbegin();
+}
+
+// Get the current metrics
+const FragmentationSummary& FragmentationMetrics::getSummary() const {
+  return summary;
+}
+
+// Get whether a block state holds file data
+bool FragmentationMetrics::isFileState(BlockState state) {
+  switch (state) {
+    case BlockState::UNOPT_BEGIN:
+    case BlockState::UNOPT_MIDDLE:
+    case BlockState::UNOPT_END:
+    case BlockState::OPTIMIZED:
+    case BlockState::READING:
+    case BlockState::INVISIBLE_UNOPT_BEGIN:
+    case BlockState::INVISIBLE_UNOPT_MIDDLE:
+    case BlockState::INVISIBLE_UNOPT_END:
+    case BlockState::INVISIBLE_OPTIMIZED:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Get whether a block state is free space
+bool FragmentationMetrics::isFreeState(BlockState state) {
+  return state == BlockState::FREE || state == BlockState::INVISIBLE_FREE;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file FrameScheduler.cpp
+ * @brief Implementation of frame-budget scheduler
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the FrameScheduler class which paces the main loop to a
+ * target frame time. It runs as many simulation steps as are due and fit in
+ * the frame budget, skips presenting frames when the simulation falls behind,
+ * and supports a turbo factor multiplying the simulation steps per tick.
+ * The simulation can also run on its own task, publishing snapshots that
+ * the render loop draws independently.
+ */
+
+#include <algorithm>
+#include "FrameScheduler.h"
+#include "PlatformCompat.h"
+
+// Selectable turbo factors (simulation steps per tick)
+static const int TURBO_FACTORS[] = {1, 4, 16};
+static const int TURBO_FACTOR_COUNT = sizeof(TURBO_FACTORS) / sizeof(TURBO_FACTORS[0]);
+
+// Constructor
+FrameScheduler::FrameScheduler()
+  : turboIndex(0),
+    appliedTurboIndex(0),
+    pendingSteps(0),
+    lastDrawTime(0),
+    skippedFrames(0),
+    lastStepCount(0),
+    taskSimulator(nullptr) {
+}
+
+// Restart pacing from the current time
+void FrameScheduler::reset() {
+  clock.reset();
+  pendingSteps = 0;
+  skippedFrames = 0;
+}
+
+// Add the simulation steps that have become due
+void FrameScheduler::queueDueSteps() {
+  // Steps counted with a previous turbo factor are dropped
+  int index = turboIndex;
+  if (index != appliedTurboIndex) {
+    appliedTurboIndex = index;
+    pendingSteps = 0;
+  }
+  
+  // Each tick due in wall-clock time is worth turbo factor simulation steps
+  // (the factor read above is used throughout, so a button press cannot mix two factors)
+  const int turboFactor = TURBO_FACTORS[index];
+  clock.advance();
+  while (clock.consumeTick()) {
+    pendingSteps += turboFactor;
+  }
+  
+  // Drop steps that cannot be caught up
+  const uint32_t maxPendingSteps = turboFactor * Config::Animation::MAX_CATCH_UP_TICKS;
+  if (pendingSteps > maxPendingSteps) {
+    pendingSteps = maxPendingSteps;
+  }
+}
+
+// Run pending steps until the time since frameStart reaches the budget
+void FrameScheduler::runPendingSteps(DefragSimulator& simulator, uint64_t frameStart, uint32_t budget) {
+  lastStepCount = 0;
+  while (pendingSteps > 0) {
+    simulator.update();
+    pendingSteps--;
+    lastStepCount++;
+    if (micros64() - frameStart >= budget) {
+      break;
+    }
+  }
+}
+
+// Run one frame
+void FrameScheduler::runFrame(DefragSimulator& simulator) {
+  uint64_t frameStart = micros64();
+  const uint32_t frameTime = Config::Scheduler::TARGET_FRAME_TIME;
+  
+  queueDueSteps();
+  
+  // Run steps while they fit in the frame budget left after drawing
+  uint32_t simulationBudget = (lastDrawTime < frameTime) ? frameTime - lastDrawTime : 0;
+  runPendingSteps(simulator, frameStart, simulationBudget);
+  
+  // Behind schedule: spend the next frame on simulation instead of presenting this one
+  if (pendingSteps > 0 && skippedFrames < Config::Scheduler::MAX_SKIPPED_FRAMES) {
+    skippedFrames++;
+    return;
+  }
+  skippedFrames = 0;
+  
+  // Draw (interpolate between ticks only when one step is one tick)
+  uint64_t drawStart = micros64();
+  float alpha = (TURBO_FACTORS[appliedTurboIndex] == 1 && pendingSteps == 0) ? clock.getInterpolationAlpha() : 1.0f;
+  simulator.draw(alpha);
+  lastDrawTime = micros64() - drawStart;
+  
+  // Wait for the rest of the frame time
+  uint64_t elapsed = micros64() - frameStart;
+  if (elapsed + 1000 <= frameTime) {
+    delay((frameTime - elapsed) / 1000);
+  }
+}
+
+// Run one simulation frame (split mode)
+void FrameScheduler::runSimulationFrame(DefragSimulator& simulator) {
+  uint64_t frameStart = micros64();
+  const uint32_t frameTime = Config::Scheduler::TARGET_FRAME_TIME;
+  
+  // Drawing happens on the other side, so the whole frame time is available
+  queueDueSteps();
+  runPendingSteps(simulator, frameStart, frameTime);
+  
+  // Hand the new state to the renderer (interpolated only when one step is one tick)
+  if (lastStepCount > 0) {
+    simulator.publishSnapshot(TURBO_FACTORS[appliedTurboIndex] == 1 && pendingSteps == 0);
+  }
+  
+  // Wait until the next tick is due (always yield so that lower-priority tasks run)
+  uint64_t elapsed = micros64() - frameStart;
+  uint32_t remaining = (elapsed < Config::Animation::TICK_INTERVAL) ? Config::Animation::TICK_INTERVAL - elapsed : 0;
+  BackgroundTask::sleepFor(std::max<uint32_t>(1, remaining / 1000));
+}
+
+// Simulation task main loop
+void FrameScheduler::simulationTaskMain(void* scheduler) {
+  FrameScheduler* self = static_cast<FrameScheduler*>(scheduler);
+  while (!self->simulationTask.isStopRequested()) {
+    self->runSimulationFrame(*self->taskSimulator);
+  }
+}
+
+// Run simulation frames on a task of their own
+bool FrameScheduler::startSimulationTask(DefragSimulator& simulator) {
+  taskSimulator = &simulator;
+  reset();
+  return simulationTask.start("simulation",
+                              Config::Scheduler::SIMULATION_TASK_CORE,
+                              Config::Scheduler::SIMULATION_TASK_PRIORITY,
+                              Config::Scheduler::SIMULATION_TASK_STACK_SIZE,
+                              &FrameScheduler::simulationTaskMain, this);
+}
+
+// Select the next turbo factor
+void FrameScheduler::cycleTurboFactor() {
+  // Pending steps are dropped by the simulation side when it sees the change
+  turboIndex = (turboIndex + 1) % TURBO_FACTOR_COUNT;
+}
+
+// Get the number of simulation steps per tick
+int FrameScheduler::getTurboFactor() const {
+  return TURBO_FACTORS[turboIndex];
+}
+
+// Get the number of simulation steps run in the last frame
+uint32_t FrameScheduler::getLastStepCount() const {
+  return lastStepCount;
+}
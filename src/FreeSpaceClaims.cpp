@@ -0,0 +1,65 @@
+/**
+ * @file FreeSpaceClaims.cpp
+ * @brief Implementation of ownership of free space shared by defrag heads
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file implements the FreeSpaceClaims class which records which head
+ * owns each cell while several heads plan moves at the same time.
+ */
+
+#include "FreeSpaceClaims.h"
+
+// Constructor
+FreeSpaceClaims::FreeSpaceClaims()
+  : cellCount(0) {
+}
+
+// Start over from a grid
+void FreeSpaceClaims::reset(const GridManager& gridManager) {
+  int columnCount = gridManager.getColumnCount();
+  int newCellCount = columnCount * gridManager.getRowCount();
+  if (newCellCount != cellCount) {
+    owners.reset(new std::atomic<int>[newCellCount]);
+    cellCount = newCellCount;
+  }
+
+  for (int cell = 0; cell < cellCount; cell++) {
+    const Block& block = gridManager.getBlock(cell % columnCount, cell / columnCount);
+    if (block.state == BlockState::FREE) {
+      owners[cell].store(UNCLAIMED);
+    } else {
+      owners[cell].store(DATA);
+    }
+  }
+}
+
+// Get the owner of a cell
+int FreeSpaceClaims::getOwner(int cell) const {
+  return owners[cell].load();
+}
+
+// Claim count cells from firstCell for a head
+bool FreeSpaceClaims::claim(int head, int firstCell, int count) {
+  std::vector<int> claimedCells;
+
+  for (int cell = firstCell; cell < firstCell + count; cell++) {
+    int owner = UNCLAIMED;
+    if (owners[cell].compare_exchange_strong(owner, head)) {
+      claimedCells.push_back(cell);
+    } else if (owner != head) {
+      // Another head was first: give back what this claim took
+      for (int claimedCell : claimedCells) {
+        owners[claimedCell].store(UNCLAIMED);
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+// Give a cell a head has just freed to that head
+void FreeSpaceClaims::assign(int cell, int head) {
+  owners[cell].store(head);
+}
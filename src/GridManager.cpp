@@ -12,17 +12,22 @@
 #include "GridManager.h"
 #include "PlatformCompat.h"
 
+// Initialize static members
+bool GridManager::useFixedSeed = false;
+uint32_t GridManager::fixedSeed = 0;
+
 // Constructor
 GridManager::GridManager() {
   initializeRNG();
   initializeGrid();
   initializeRandomGrid();
+  rebuildFragmentationMetrics();
 }
 
 // Initialize random number generator
 void GridManager::initializeRNG() {
-  // Use a different seed each time
-  uint32_t seed = seed();
+  // Use a different seed each time unless a fixed seed is set
+  uint32_t seed = useFixedSeed ? fixedSeed : seed();
   rng = std::mt19937(seed);
 }
 
@@ -105,6 +110,33 @@ void GridManager::setInitialBlockState(int x, int y, int randomValue, BlockState
   }
 }
 
+// Change the state of a block
+void GridManager::setBlockState(int x, int y, BlockState state) {
+  setBlockState(x, y, state, grid[y][x].fileID);
+}
+
+// Change the state and file of a block
+void GridManager::setBlockState(int x, int y, BlockState state, int fileID) {
+  grid[y][x].state = state;
+  grid[y][x].fileID = fileID;
+  fragmentationMetrics.update(y * getColumnCount() + x, state, fileID);
+}
+
+// Recompute the fragmentation metrics from all blocks
+void GridManager::rebuildFragmentationMetrics() {
+  fragmentationMetrics.reset(getRowCount() * getColumnCount());
+  for (int y = 0; y < getRowCount(); y++) {
+    for (int x = 0; x < getColumnCount(); x++) {
+      fragmentationMetrics.update(y * getColumnCount() + x, grid[y][x].state, grid[y][x].fileID);
+    }
+  }
+}
+
+// Get the fragmentation metrics
+const FragmentationMetrics& GridManager::getFragmentationMetrics() const {
+  return fragmentationMetrics;
+}
+
 // Access to grid
 Block& GridManager::getBlock(int x, int y) {
   return grid[y][x];
@@ -136,3 +168,9 @@ const std::vector<Block>& GridManager::getRow(int y) const {
 std::mt19937& GridManager::getRNG() {
   return rng;
 }
+
+// Use a fixed random seed for all grids created afterwards
+void GridManager::setFixedSeed(uint32_t seed) {
+  useFixedSeed = true;
+  fixedSeed = seed;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file InputManager.cpp
+ * @brief Implementation of input sampling
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the InputManager class which samples the touch panel
+ * (the mouse in the native SDL build) and the buttons from loop().
+ */
+
+#include <M5Unified.h>
+#include "InputManager.h"
+#include "DefragSimulator.h"
+#include "PlatformCompat.h"
+
+// Constructor
+InputManager::InputManager()
+  : simulator(nullptr) {
+}
+
+// Set the simulator that receives touches and button B clicks
+void InputManager::begin(DefragSimulator& touchTarget) {
+  simulator = &touchTarget;
+}
+
+// Take the next button event
+bool InputManager::pollButtonEvent(InputEvent& event) {
+  return buttonEvents.pop(event);
+}
+
+// Sample touch and buttons once
+void InputManager::sample() {
+  M5.update();
+  uint64_t now = micros64();
+  
+  // Check touch events
+  if (M5.Touch.getCount() > 0) {
+    auto touch = M5.Touch.getDetail();
+    if (touch.wasPressed()) {
+      InputEvent event;
+      event.type = InputEventType::TOUCH_PRESSED;
+      event.x = touch.x;
+      event.y = touch.y;
+      event.timestamp = now;
+      simulator->postInputEvent(event);
+    }
+  }
+  
+  // Check button events
+  if (M5.BtnA.wasClicked()) {
+    InputEvent event;
+    event.type = InputEventType::BUTTON_A_CLICKED;
+    event.x = 0;
+    event.y = 0;
+    event.timestamp = now;
+    buttonEvents.push(event);
+  }
+  
+  // Button B changes the simulation, so it goes to the simulator like touches
+  if (M5.BtnB.wasClicked()) {
+    InputEvent event;
+    event.type = InputEventType::BUTTON_B_CLICKED;
+    event.x = 0;
+    event.y = 0;
+    event.timestamp = now;
+    simulator->postInputEvent(event);
+  }
+}
+
@@ -0,0 +1,189 @@
+/**
+ * @file IoScheduler.cpp
+ * @brief Implementation of I/O request queue and scheduling
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the IoScheduler class which orders the block reads
+ * and writes of each move and keeps track of the head travel.
+ */
+
+#include "IoScheduler.h"
+#include <algorithm>
+
+// Distance between two clusters
+static int seekDistance(int fromCell, int toCell) {
+  return (toCell > fromCell) ? toCell - fromCell : fromCell - toCell;
+}
+
+// Constructor
+IoScheduler::IoScheduler(IoPolicy policy, int queueDepth, DiskModelType diskModelType)
+  : policy(policy),
+    queueDepth(std::max(queueDepth, 1)),
+    columnCount(0),
+    headCell(0),
+    direction(1),
+    headTravel(0),
+    requestCount(0),
+    operationCount(0),
+    lastWasWrite(false),
+    diskModel(DiskModel::create(diskModelType, 0)) {
+}
+
+// Reset
+void IoScheduler::reset(int columnCount, int rowCount) {
+  this->columnCount = columnCount;
+  headCell = 0;
+  direction = 1;
+  headTravel = 0;
+  requestCount = 0;
+  operationCount = 0;
+  lastWasWrite = false;
+  diskModel->reset(columnCount * rowCount);
+}
+
+// Choose the next request among the first window queued requests
+int IoScheduler::chooseRequest(const std::vector<Request>& queue, int window) {
+  // A write can only be serviced once its block has been read
+  std::vector<int> candidates;
+  for (int i = 0; i < window; i++) {
+    if (!queue[i].isWrite || readBlocks[queue[i].block]) {
+      candidates.push_back(i);
+    }
+  }
+  if (policy == IoPolicy::FIFO) {
+    return candidates[0];
+  }
+
+  // The nearest request (ahead in the sweep direction for the elevator; earliest queued on ties)
+  for (int pass = 0; pass < 2; pass++) {
+    int chosen = -1;
+    for (int i : candidates) {
+      int offset = queue[i].cell - headCell;
+      if (policy == IoPolicy::ELEVATOR && offset * direction < 0) {
+        continue;
+      }
+      if (chosen < 0 || seekDistance(headCell, queue[i].cell) < seekDistance(headCell, queue[chosen].cell)) {
+        chosen = i;
+      }
+    }
+    if (chosen >= 0) {
+      return chosen;
+    }
+
+    // Nothing left ahead: the elevator turns around
+    direction = -direction;
+  }
+  return candidates[0];
+}
+
+// Service queued requests until the queue is empty
+void IoScheduler::serviceRequests(std::vector<Request>& queue, int depth, uint64_t issueTime,
+                                  std::vector<int>& readOrder) {
+  while (!queue.empty()) {
+    int window = std::min((int)queue.size(), depth);
+    int chosen = chooseRequest(queue, window);
+    Request request = queue[chosen];
+    queue.erase(queue.begin() + chosen);
+
+    // A request continuing the previous one in the next cluster joins its operation
+    if (requestCount == 0 || request.isWrite != lastWasWrite || request.cell != headCell + 1) {
+      operationCount++;
+    }
+    lastWasWrite = request.isWrite;
+    
+    // Move the head to the request
+    if (request.cell != headCell) {
+      direction = (request.cell > headCell) ? 1 : -1;
+    }
+    headTravel += seekDistance(headCell, request.cell);
+    headCell = request.cell;
+    requestCount++;
+    diskModel->access(request.cell, request.isWrite, issueTime);
+
+    if (!request.isWrite) {
+      readBlocks[request.block] = true;
+      readOrder.push_back(request.block);
+    }
+  }
+}
+
+// Service the reads and writes of a move
+void IoScheduler::schedule(PlannedMove& move, bool staged, uint64_t issueTime) {
+  // Files optimized in place are not read or written
+  if (move.targetPositions.empty()) {
+    return;
+  }
+
+  std::vector<Request> reads;
+  std::vector<Request> writes;
+  for (size_t i = 0; i < move.fileBlocks.size(); i++) {
+    Request read = {move.fileBlocks[i].second * columnCount + move.fileBlocks[i].first, (int)i, false};
+    Request write = {move.targetPositions[i].second * columnCount + move.targetPositions[i].first, (int)i, true};
+    reads.push_back(read);
+    writes.push_back(write);
+  }
+  readBlocks.assign(move.fileBlocks.size(), false);
+  
+  std::vector<int> readOrder;
+  if (staged) {
+    // Through the staging buffer: the engine issues all reads in one sweep in disk order,
+    // then all writes in disk order (it has sorted them itself, so the queue does not reorder them)
+    auto byCell = [](const Request& a, const Request& b) {
+      return a.cell < b.cell;
+    };
+    std::sort(reads.begin(), reads.end(), byCell);
+    std::sort(writes.begin(), writes.end(), byCell);
+    serviceRequests(reads, 1, issueTime, readOrder);
+    serviceRequests(writes, 1, issueTime, readOrder);
+  } else {
+    // Block by block: each read is followed by the write of the same block
+    std::vector<Request> queue;
+    for (size_t i = 0; i < reads.size(); i++) {
+      queue.push_back(reads[i]);
+      queue.push_back(writes[i]);
+    }
+    serviceRequests(queue, queueDepth, issueTime, readOrder);
+  }
+
+  // Blocks start moving in the order they were read (each keeps its own target)
+  PlannedMove scheduledMove = move;
+  for (size_t i = 0; i < readOrder.size(); i++) {
+    scheduledMove.fileBlocks[i] = move.fileBlocks[readOrder[i]];
+    scheduledMove.targetPositions[i] = move.targetPositions[readOrder[i]];
+  }
+  move = scheduledMove;
+}
+
+// Get the distance travelled by the head
+uint64_t IoScheduler::getHeadTravel() const {
+  return headTravel;
+}
+
+// Get the number of requests serviced
+uint32_t IoScheduler::getRequestCount() const {
+  return requestCount;
+}
+
+// Get the number of I/O operations (runs of requests to consecutive clusters)
+uint32_t IoScheduler::getOperationCount() const {
+  return operationCount;
+}
+
+// Get the timing model of the drive
+const DiskModel& IoScheduler::getDiskModel() const {
+  return *diskModel;
+}
+
+// Get the name of a policy
+const char* IoScheduler::getPolicyName(IoPolicy policy) {
+  switch (policy) {
+    case IoPolicy::ELEVATOR:
+      return "elevator";
+    case IoPolicy::NCQ:
+      return "ncq";
+    default:
+      return "fifo";
+  }
+}
@@ -0,0 +1,120 @@
+/**
+ * @file MovePlanner.cpp
+ * @brief Implementation of background planning of file moves
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the MovePlanner class which searches for the next file
+ * moves on a background task while the current move is animating.
+ */
+
+#include "MovePlanner.h"
+
+// Constructor
+MovePlanner::MovePlanner()
+  : planningGrid(),
+    planningFiles(planningGrid),
+    strategy(DefragStrategy::create(Config::Planner::STRATEGY)),
+    exhausted(false),
+    begun(false),
+    plannedMoveCount(-1),
+    plannedBlockCount(-1) {
+}
+
+// Start planning the moves for a grid
+void MovePlanner::begin(const GridManager& gridManager) {
+  stop();
+  
+  // The task is stopped, so the planning grid can be replaced safely
+  planningGrid = gridManager;
+  exhausted = false;
+  begun = false;
+  plannedMoveCount = -1;
+  plannedBlockCount = -1;
+  task.start("planner",
+             Config::Planner::TASK_CORE,
+             Config::Planner::TASK_PRIORITY,
+             Config::Planner::TASK_STACK_SIZE,
+             &MovePlanner::taskMain, this);
+}
+
+// Stop planning
+void MovePlanner::stop() {
+  task.stop();
+  
+  PlannedMove move;
+  while (readyMoves.pop(move)) {
+  }
+}
+
+// Get whether the strategy has begun
+bool MovePlanner::hasBegun() const {
+  return begun;
+}
+
+// Take the next planned move
+bool MovePlanner::takeNextMove(PlannedMove& move) {
+  while (true) {
+    if (readyMoves.pop(move)) {
+      return true;
+    }
+    
+    // Check the queue once more after seeing the flag: the last move is queued before the flag is set
+    if (exhausted) {
+      return readyMoves.pop(move);
+    }
+    
+    // The planner has fallen behind (or is not running): wait for the move being planned
+    if (!task.isRunning()) {
+      return false;
+    }
+    BackgroundTask::sleepFor(1);
+  }
+}
+
+// Get the number of moves planned up front
+int MovePlanner::getPlannedMoveCount() const {
+  return plannedMoveCount;
+}
+
+// Get the number of blocks moved by the moves planned up front
+int MovePlanner::getPlannedBlockCount() const {
+  return plannedBlockCount;
+}
+
+// Hand over a move, waiting while the queue is full
+bool MovePlanner::handOver(const PlannedMove& move) {
+  // Wait while the queue is full (the pipeline is far enough ahead)
+  while (!readyMoves.push(move)) {
+    if (task.isStopRequested()) {
+      return false;
+    }
+    BackgroundTask::sleepFor(Config::Planner::IDLE_INTERVAL);
+  }
+  return true;
+}
+
+// Planner task main loop
+void MovePlanner::taskMain(void* planner) {
+  MovePlanner* self = static_cast<MovePlanner*>(planner);
+  
+  // Strategies planning the whole drive do it here, and report the size of the plan
+  // before the first move is handed over
+  self->strategy->begin(self->planningGrid, self->planningFiles);
+  self->plannedMoveCount = self->strategy->getPlannedMoveCount();
+  self->plannedBlockCount = self->strategy->getPlannedBlockCount();
+  self->begun = true;
+  
+  PlannedMove move;
+  while (!self->task.isStopRequested()) {
+    // Plan the next move (its result is applied to the planning grid at once)
+    if (!self->strategy->planNextMove(self->planningGrid, self->planningFiles, move)) {
+      self->exhausted = true;
+      return;
+    }
+    if (!self->handOver(move)) {
+      return;
+    }
+  }
+}
@@ -0,0 +1,240 @@
+/**
+ * @file MultiHeadPlanner.cpp
+ * @brief Implementation of region-parallel planning of file moves
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file implements the MultiHeadPlanner class which plans the moves of
+ * several defrag heads, one per region of the disk, at the same time.
+ */
+
+#include "MultiHeadPlanner.h"
+#include <cstdio>
+
+// Constructor
+MultiHeadPlanner::MultiHeadPlanner(int headCount)
+  : headCount(headCount),
+    columnCount(0),
+    rowCount(0) {
+#ifdef ARDUINO
+  // One planner task plans all heads
+  workerCount = 1;
+#else
+  // A worker thread per head
+  workerCount = headCount;
+#endif
+
+  for (int i = 0; i < headCount; i++) {
+    heads.push_back(std::unique_ptr<Head>(new Head()));
+    heads.back()->hasPendingMove = false;
+    heads.back()->exhausted = true;
+  }
+  for (int i = 0; i < workerCount; i++) {
+    workers.push_back(std::unique_ptr<Worker>(new Worker()));
+    workers.back()->planner = this;
+    workers.back()->index = i;
+  }
+}
+
+// Start planning the moves for a grid
+void MultiHeadPlanner::begin(GridManager& gridManager, FileManager& fileManager) {
+  stop();
+
+  // The workers are stopped, so the heads can be set up safely
+  columnCount = gridManager.getColumnCount();
+  rowCount = gridManager.getRowCount();
+  claims.reset(gridManager);
+  splitRegions(gridManager, fileManager);
+
+  for (auto &worker : workers) {
+    char name[16];
+    snprintf(name, sizeof(name), "head%d", worker->index);
+    worker->task.start(name,
+                       Config::Planner::TASK_CORE,
+                       Config::Planner::TASK_PRIORITY,
+                       Config::Planner::TASK_STACK_SIZE,
+                       &MultiHeadPlanner::taskMain, worker.get());
+  }
+}
+
+// Stop planning
+void MultiHeadPlanner::stop() {
+  for (auto &worker : workers) {
+    worker->task.stop();
+  }
+
+  PlannedMove move;
+  for (auto &head : heads) {
+    while (head->readyMoves.pop(move)) {
+    }
+    head->hasPendingMove = false;
+    head->exhausted = true;
+  }
+}
+
+// Take the next planned move of a head
+bool MultiHeadPlanner::takeNextMove(int headIndex, PlannedMove& move) {
+  Head& head = *heads[headIndex];
+  const BackgroundTask& task = workers[headIndex % workerCount]->task;
+
+  while (true) {
+    if (head.readyMoves.pop(move)) {
+      return true;
+    }
+
+    // Check the queue once more after seeing the flag: the last move is queued before the flag is set
+    if (head.exhausted) {
+      return head.readyMoves.pop(move);
+    }
+
+    // The head's worker has fallen behind (or is not running): wait for the move being planned
+    if (!task.isRunning()) {
+      return false;
+    }
+    BackgroundTask::sleepFor(1);
+  }
+}
+
+// Get the number of heads
+int MultiHeadPlanner::getHeadCount() const {
+  return headCount;
+}
+
+// Get the head whose region holds a cell
+int MultiHeadPlanner::getRegionHead(int x, int y) const {
+  int cell = y * columnCount + x;
+  for (int i = 0; i < headCount; i++) {
+    if (cell < heads[i]->endCell) {
+      return i;
+    }
+  }
+  return headCount - 1;
+}
+
+// Split the fragmented files of the grid into the regions of the heads
+void MultiHeadPlanner::splitRegions(GridManager&, FileManager& fileManager) {
+  // Each region is a band of whole rows
+  for (int i = 0; i < headCount; i++) {
+    Head& head = *heads[i];
+    head.firstCell = (i * rowCount / headCount) * columnCount;
+    head.endCell = ((i + 1) * rowCount / headCount) * columnCount;
+    head.files.clear();
+    head.nextFile = 0;
+    head.freeCells.assign(columnCount * rowCount, false);
+    head.exhausted = false;
+  }
+
+  // A file spanning several regions belongs wholly to the region of its first block,
+  // so it is still written as one run
+  std::vector<PlannedMove> files;
+  fileManager.collectUnoptimizedFiles(files);
+  for (const auto &file : files) {
+    const auto &firstBlock = file.fileBlocks[0];
+    heads[getRegionHead(firstBlock.first, firstBlock.second)]->files.push_back(file);
+  }
+}
+
+// Claim the first free run of count cells between firstCell and endCell
+int MultiHeadPlanner::claimFreeRun(int headIndex, int firstCell, int endCell, int count) {
+  Head& head = *heads[headIndex];
+  int runStart = firstCell;
+
+  for (int cell = firstCell; cell < endCell; cell++) {
+    // A run continues through cells that are free and either the head's own or unclaimed
+    if (!head.freeCells[cell] && claims.getOwner(cell) != FreeSpaceClaims::UNCLAIMED) {
+      runStart = cell + 1;
+      continue;
+    }
+    if (cell - runStart + 1 < count) {
+      continue;
+    }
+
+    if (claims.claim(headIndex, runStart, count)) {
+      return runStart;
+    }
+
+    // Another head claimed part of the run first: search again from the next cell
+    runStart++;
+    cell = runStart - 1;
+  }
+  return -1;
+}
+
+// Plan the next move of a head
+bool MultiHeadPlanner::planNextMove(int headIndex, PlannedMove& move) {
+  Head& head = *heads[headIndex];
+  if (head.nextFile >= head.files.size()) {
+    return false;
+  }
+  move = head.files[head.nextFile++];
+  int count = move.fileBlocks.size();
+
+  // First fit in the head's own region, then anywhere on the disk
+  int firstCell = claimFreeRun(headIndex, head.firstCell, head.endCell, count);
+  if (firstCell < 0) {
+    firstCell = claimFreeRun(headIndex, 0, columnCount * rowCount, count);
+  }
+
+  // Without room the file is optimized where it is
+  move.targetPositions.clear();
+  if (firstCell < 0) {
+    return true;
+  }
+
+  for (int cell = firstCell; cell < firstCell + count; cell++) {
+    move.targetPositions.push_back(std::make_pair(cell % columnCount, cell / columnCount));
+    head.freeCells[cell] = false;
+  }
+
+  // The cells the file leaves become free space of this head
+  // (a later move of the head in the same batch may write them: the copy engine reads a batch before writing it)
+  for (const auto &position : move.fileBlocks) {
+    int cell = position.second * columnCount + position.first;
+    head.freeCells[cell] = true;
+    claims.assign(cell, headIndex);
+  }
+  return true;
+}
+
+// Worker task main loop
+void MultiHeadPlanner::taskMain(void* worker) {
+  Worker* self = static_cast<Worker*>(worker);
+  MultiHeadPlanner* planner = self->planner;
+
+  while (!self->task.isStopRequested()) {
+    bool anyHeadLeft = false;
+    bool queuedAny = false;
+
+    for (int i = self->index; i < planner->headCount; i += planner->workerCount) {
+      Head& head = *planner->heads[i];
+      if (head.exhausted) {
+        continue;
+      }
+
+      // Plan a move unless one is still waiting for room in the queue
+      if (!head.hasPendingMove) {
+        if (!planner->planNextMove(i, head.pendingMove)) {
+          head.exhausted = true;
+          continue;
+        }
+        head.hasPendingMove = true;
+      }
+      anyHeadLeft = true;
+
+      if (head.readyMoves.push(head.pendingMove)) {
+        head.hasPendingMove = false;
+        queuedAny = true;
+      }
+    }
+
+    if (!anyHeadLeft) {
+      return;
+    }
+
+    // Wait while the queues of all heads are full (the pipeline is far enough ahead)
+    if (!queuedAny) {
+      BackgroundTask::sleepFor(Config::Planner::IDLE_INTERVAL);
+    }
+  }
+}
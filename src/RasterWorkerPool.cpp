@@ -0,0 +1,106 @@
+/**
+ * @file RasterWorkerPool.cpp
+ * @brief Implementation of worker thread pool for parallel rasterization
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the RasterWorkerPool class which keeps a small set of
+ * worker threads alive and runs indexed jobs (one per canvas tile) on them.
+ * It is only available in the native PC/SDL environment.
+ */
+
+#include "RasterWorkerPool.h"
+
+#ifndef ARDUINO
+
+// Constructor
+RasterWorkerPool::RasterWorkerPool()
+  : jobCount(0),
+    nextJob(0),
+    pendingJobs(0),
+    stopping(false) {
+}
+
+// Destructor
+RasterWorkerPool::~RasterWorkerPool() {
+  stop();
+}
+
+// Start worker threads
+void RasterWorkerPool::start(int threadCount) {
+  stop();
+  stopping = false;
+
+  // The calling thread is one of the threads taking jobs
+  for (int i = 1; i < threadCount; i++) {
+    workers.emplace_back(&RasterWorkerPool::workerLoop, this);
+  }
+}
+
+// Stop worker threads
+void RasterWorkerPool::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wakeCondition.notify_all();
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  workers.clear();
+}
+
+// Get the number of threads taking jobs, including the calling thread
+int RasterWorkerPool::getThreadCount() const {
+  return workers.size() + 1;
+}
+
+// Take and run jobs until the current batch is exhausted
+void RasterWorkerPool::runJobs(std::unique_lock<std::mutex>& lock) {
+  while (nextJob < jobCount) {
+    int index = nextJob++;
+
+    // Run the job without holding the lock
+    lock.unlock();
+    job(index);
+    lock.lock();
+
+    // Wake the caller when the last job has finished
+    if (--pendingJobs == 0) {
+      doneCondition.notify_all();
+    }
+  }
+}
+
+// Worker thread main loop
+void RasterWorkerPool::workerLoop() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    wakeCondition.wait(lock, [this] { return stopping || nextJob < jobCount; });
+    if (stopping) {
+      return;
+    }
+    runJobs(lock);
+  }
+}
+
+// Run job(0) ... job(count - 1) in parallel and wait until all are done
+void RasterWorkerPool::run(int count, const std::function<void(int)>& batchJob) {
+  std::unique_lock<std::mutex> lock(mutex);
+  job = batchJob;
+  jobCount = count;
+  nextJob = 0;
+  pendingJobs = count;
+  wakeCondition.notify_all();
+
+  // Take jobs on the calling thread too, then wait for the workers
+  runJobs(lock);
+  doneCondition.wait(lock, [this] { return pendingJobs == 0; });
+
+  jobCount = 0;
+  nextJob = 0;
+}
+
+#endif
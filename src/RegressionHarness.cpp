@@ -0,0 +1,455 @@
+/**
+ * @file RegressionHarness.cpp
+ * @brief Implementation of headless golden-image regression harness
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the RegressionHarness class which runs a seeded
+ * simulation without a display, hashes the rendered frame at chosen frame
+ * numbers and compares the hashes against stored golden frames, reporting
+ * the frame time next to each comparison.
+ */
+
+#include "RegressionHarness.h"
+
+#ifndef ARDUINO
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "Config.h"
+#include "GridManager.h"
+#include "RenderTarget.h"
+#include "DefragSimulator.h"
+#include "BackgroundTask.h"
+#include "PlatformCompat.h"
+
+// Canvases for off-screen rendering (defined in main.cpp)
+extern M5Canvas canvas;
+extern M5Canvas backCanvas;
+
+// Initialize static member
+RegressionHarness* RegressionHarness::activeHarness = nullptr;
+
+// Band height of the banded setup compared in differential mode (in pixels)
+static const int DIFFERENTIAL_BAND_HEIGHT = 37;
+
+// Constructor (default settings)
+RegressionOptions::RegressionOptions()
+  : randomSeed(1),
+    width(320),
+    height(240),
+    checkpoints{1, 10, 30, 60, 100, 200, 400},
+    touchFrame(-1),
+    touchX(160),
+    touchY(120),
+    goldenPath("golden_frames.txt"),
+    record(false),
+    consolidation(Config::Consolidation::ENABLED),
+    metrics(false),
+    hashGrid(false),
+    differential(false) {
+}
+
+// Constructor
+RegressionHarness::RegressionHarness(const RegressionOptions& options)
+  : options(options),
+    movingCheckpoints(0),
+    debrisCheckpoints(0) {
+}
+
+// Parse command line arguments into options
+bool RegressionHarness::parseArguments(int argc, char** argv, RegressionOptions& options) {
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+    if (strcmp(arg, "--record") == 0) {
+      options.record = true;
+    } else if (strcmp(arg, "--no-consolidation") == 0) {
+      options.consolidation = false;
+    } else if (strcmp(arg, "--metrics") == 0) {
+      options.metrics = true;
+    } else if (strcmp(arg, "--grid") == 0) {
+      options.hashGrid = true;
+    } else if (strcmp(arg, "--differential") == 0) {
+      options.differential = true;
+    } else if (strcmp(arg, "--seed") == 0 && value != nullptr) {
+      options.randomSeed = strtoul(value, nullptr, 10);
+      i++;
+    } else if (strcmp(arg, "--size") == 0 && value != nullptr) {
+      if (sscanf(value, "%dx%d", &options.width, &options.height) != 2) {
+        return false;
+      }
+      i++;
+    } else if (strcmp(arg, "--frames") == 0 && value != nullptr) {
+      // Comma-separated list of frame numbers
+      options.checkpoints.clear();
+      for (const char* p = value; *p != '\0'; ) {
+        char* end = nullptr;
+        int frame = strtol(p, &end, 10);
+        if (end == p || frame <= 0) {
+          return false;
+        }
+        options.checkpoints.push_back(frame);
+        p = (*end == ',') ? end + 1 : end;
+      }
+      i++;
+    } else if (strcmp(arg, "--touch") == 0 && value != nullptr) {
+      // Frame number and screen coordinates of a touch: frame,x,y
+      if (sscanf(value, "%d,%d,%d", &options.touchFrame, &options.touchX, &options.touchY) != 3) {
+        return false;
+      }
+      i++;
+    } else if (strcmp(arg, "--golden") == 0 && value != nullptr) {
+      options.goldenPath = value;
+      i++;
+    } else if (strcmp(arg, "--dump") == 0 && value != nullptr) {
+      options.dumpDirectory = value;
+      i++;
+    } else {
+      fprintf(stderr,
+              "Usage: %s [--record] [--seed N] [--size WxH] [--frames N,N,...]\n"
+              "          [--touch FRAME,X,Y] [--golden FILE] [--dump DIR] [--no-consolidation]\n"
+              "          [--metrics] [--grid] [--differential]\n", argv[0]);
+      return false;
+    }
+  }
+
+  std::sort(options.checkpoints.begin(), options.checkpoints.end());
+  options.checkpoints.erase(std::unique(options.checkpoints.begin(), options.checkpoints.end()),
+                            options.checkpoints.end());
+  return !options.checkpoints.empty();
+}
+
+// Receive a finished canvas (band) from the renderer
+void RegressionHarness::onPresent(M5Canvas& canvas, int originX, int originY) {
+  RegressionHarness* harness = activeHarness;
+  int width = harness->options.width;
+  int height = harness->options.height;
+
+  // Copy the visible part of the band into the frame.
+  // readPixel expands palette indices, so the frame is independent of the canvas format.
+  for (int y = 0; y < canvas.height() && originY + y < height; y++) {
+    for (int x = 0; x < canvas.width() && originX + x < width; x++) {
+      harness->framePixels[(originY + y) * width + originX + x] = canvas.readPixel(x, y);
+    }
+  }
+
+  // Keep the raw canvas too (differential mode compares the bytes of some setups)
+  if (harness->options.differential) {
+    const uint8_t* buffer = static_cast<const uint8_t*>(canvas.getBuffer());
+    harness->frameBytes.insert(harness->frameBytes.end(), buffer, buffer + canvas.bufferLength());
+  }
+}
+
+// Hash the assembled frame
+uint64_t RegressionHarness::hashFrame() const {
+  uint64_t hash = 14695981039346656037ULL;
+  for (uint16_t pixel : framePixels) {
+    hash = (hash ^ (pixel & 0xFF)) * 1099511628211ULL;
+    hash = (hash ^ (pixel >> 8)) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+// Hash the simulated grid
+uint64_t RegressionHarness::hashGridState() const {
+  const GridManager& gridManager = defragSim.getGridManager();
+  uint64_t hash = 14695981039346656037ULL;
+  for (int y = 0; y < gridManager.getRowCount(); y++) {
+    for (int x = 0; x < gridManager.getColumnCount(); x++) {
+      const Block& block = gridManager.getBlock(x, y);
+      const int32_t values[] = {(int32_t)block.state, block.fileID, block.animX, block.animY};
+      for (int32_t value : values) {
+        for (int shift = 0; shift < 32; shift += 8) {
+          hash = (hash ^ (((uint32_t)value >> shift) & 0xFF)) * 1099511628211ULL;
+        }
+      }
+    }
+  }
+  return hash;
+}
+
+// Draw the last snapshot again through a render setup and copy the frame
+uint32_t RegressionHarness::drawWithSetup(const RenderSetup& setup, float alpha, std::vector<uint16_t>& pixels) {
+  defragSim.applyRenderSetup(setup);
+  framePixels.assign(framePixels.size(), 0);
+  frameBytes.clear();
+  uint32_t startTime = micros();
+  defragSim.redrawSnapshot(alpha);
+  uint32_t drawTime = micros() - startTime;
+  pixels = framePixels;
+  return drawTime;
+}
+
+// Draw the last snapshot through the reference setup and the checked setups and compare the frames
+bool RegressionHarness::compareRenderSetups(int frame) {
+  // A palettized canvas must show the same colors as the direct RGB565 one
+  RenderSetup palettized = RenderSetup::reference();
+  palettized.colorDepth = 4;
+
+  // The configured fast paths, and the same with band rendering
+  // (bands that are not a multiple of the tile height, so blocks cross band and tile edges)
+  RenderSetup banded = RenderSetup::configured();
+  banded.bandHeight = DIFFERENTIAL_BAND_HEIGHT;
+  banded.doubleBuffer = true;
+
+  const struct {
+    const char* name;
+    RenderSetup setup;
+  } checkedSetups[] = {
+    {"4-bit", palettized},
+    {"configured", RenderSetup::configured()},
+    {"banded", banded}
+  };
+
+  std::vector<uint16_t> referencePixels;
+  uint32_t referenceTime = drawWithSetup(RenderSetup::reference(), 1.0f, referencePixels);
+  printf("frame %5d  reference %8.3f ms", frame, referenceTime / 1000.0);
+
+  bool matched = true;
+  for (const auto &checked : checkedSetups) {
+    std::vector<uint16_t> pixels;
+    uint32_t drawTime = drawWithSetup(checked.setup, 1.0f, pixels);
+    int differingPixels = 0;
+    for (size_t i = 0; i < pixels.size(); i++) {
+      if (pixels[i] != referencePixels[i]) {
+        differingPixels++;
+      }
+    }
+    if (differingPixels == 0) {
+      printf("  %s OK %8.3f ms", checked.name, drawTime / 1000.0);
+    } else {
+      printf("  %s MISMATCH (%d pixels) %8.3f ms", checked.name, differingPixels, drawTime / 1000.0);
+      matched = false;
+    }
+  }
+
+  // Tile-parallel rasterization must leave the same bytes in the canvas as the serial one,
+  // also between ticks, where blocks in flight and debris straddle tile edges
+  const RenderSnapshot& snapshot = defragSim.getDrawnSnapshot();
+  if (!snapshot.movingBlocks.empty()) {
+    movingCheckpoints++;
+  }
+  if (snapshot.particles.getCount() > 0) {
+    debrisCheckpoints++;
+  }
+  bool tilesMatched = true;
+  const RenderSetup rasterSetups[] = {RenderSetup::configured(), banded};
+  for (const auto &setup : rasterSetups) {
+    for (float alpha : {1.0f, 0.5f}) {
+      tilesMatched = compareRasterThreads(setup, alpha) && tilesMatched;
+    }
+  }
+  printf("  tiles %s (%d moving, %d debris)\n", tilesMatched ? "OK" : "MISMATCH",
+         static_cast<int>(snapshot.movingBlocks.size()), snapshot.particles.getCount());
+
+  // The simulation goes on with the configured setup
+  defragSim.applyRenderSetup(RenderSetup::configured());
+  return matched && tilesMatched;
+}
+
+// Rasterize the last snapshot with one thread and with the configured raster threads and compare the canvas bytes
+bool RegressionHarness::compareRasterThreads(const RenderSetup& setup, float alpha) {
+  std::vector<uint16_t> pixels;
+  RenderSetup serial = setup;
+  serial.rasterThreads = 1;
+  drawWithSetup(serial, alpha, pixels);
+  std::vector<uint8_t> serialBytes = frameBytes;
+
+  RenderSetup parallel = setup;
+  parallel.rasterThreads = Config::Render::RASTER_THREADS;
+  drawWithSetup(parallel, alpha, pixels);
+  return frameBytes.size() == serialBytes.size() &&
+         memcmp(frameBytes.data(), serialBytes.data(), serialBytes.size()) == 0;
+}
+
+// Write the assembled frame as a PPM image
+bool RegressionHarness::dumpFrame(int frame) const {
+  char path[512];
+  snprintf(path, sizeof(path), "%s/frame_%05d.ppm", options.dumpDirectory.c_str(), frame);
+  FILE* file = fopen(path, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  fprintf(file, "P6\n%d %d\n255\n", options.width, options.height);
+  for (uint16_t pixel : framePixels) {
+    uint8_t rgb[3] = {
+      static_cast<uint8_t>(((pixel >> 11) & 0x1F) * 255 / 31),
+      static_cast<uint8_t>(((pixel >> 5) & 0x3F) * 255 / 63),
+      static_cast<uint8_t>((pixel & 0x1F) * 255 / 31)
+    };
+    fwrite(rgb, 1, sizeof(rgb), file);
+  }
+  fclose(file);
+  return true;
+}
+
+// Print the fragmentation metrics of the simulated drive
+bool RegressionHarness::printMetrics() const {
+  const GridManager& gridManager = defragSim.getGridManager();
+  const FragmentationSummary& summary = gridManager.getFragmentationMetrics().getSummary();
+
+  // The same grid with its metrics computed from scratch
+  GridManager rescanned = gridManager;
+  rescanned.rebuildFragmentationMetrics();
+  bool matches = rescanned.getFragmentationMetrics().getSummary() == summary;
+
+  printf("  files %d (%d%% fragmented, %.2f fragments/file, %.2f blocks/fragment)  "
+         "free %d blocks in %d extents (largest %d)%s\n",
+         summary.fileCount, summary.getFragmentedFilePercentage(), summary.getFragmentsPerFile(),
+         summary.getAverageFragmentSize(), summary.freeBlockCount, summary.freeExtentCount,
+         summary.largestFreeExtent, matches ? "" : "  RESCAN DIFFERS");
+  return matches;
+}
+
+// Load golden frame hashes
+bool RegressionHarness::loadGoldens(std::map<int, uint64_t>& goldens) const {
+  FILE* file = fopen(options.goldenPath.c_str(), "r");
+  if (file == nullptr) {
+    return false;
+  }
+
+  // One "frame hash" pair per line, lines starting with '#' are comments
+  char line[256];
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    int frame = 0;
+    uint64_t hash = 0;
+    if (line[0] != '#' && sscanf(line, "%d %" SCNx64, &frame, &hash) == 2) {
+      goldens[frame] = hash;
+    }
+  }
+  fclose(file);
+  return true;
+}
+
+// Save golden frame hashes
+bool RegressionHarness::saveGoldens(const std::map<int, uint64_t>& goldens) const {
+  FILE* file = fopen(options.goldenPath.c_str(), "w");
+  if (file == nullptr) {
+    return false;
+  }
+
+  fprintf(file, "# seed %" PRIu32 ", size %dx%d, touch %d,%d,%d\n",
+          options.randomSeed, options.width, options.height,
+          options.touchFrame, options.touchX, options.touchY);
+  for (const auto &golden : goldens) {
+    fprintf(file, "%d %016" PRIx64 "\n", golden.first, golden.second);
+  }
+  fclose(file);
+  return true;
+}
+
+// Run the simulation and compare or record checkpoint frames
+int RegressionHarness::run() {
+  std::map<int, uint64_t> goldens;
+  if (!options.record && !options.differential && !loadGoldens(goldens)) {
+    fprintf(stderr, "Cannot read golden frames from %s (use --record to create them)\n",
+            options.goldenPath.c_str());
+    return 1;
+  }
+
+  // Set up the screen without a display: finished canvases come to onPresent
+  Config::getInstance()->initialize(options.width, options.height);
+  if (!RenderTarget::createCanvases(canvas, backCanvas, options.width, options.height)) {
+    fprintf(stderr, "Cannot create a %dx%d canvas\n", options.width, options.height);
+    return 1;
+  }
+  framePixels.assign(options.width * options.height, 0);
+  activeHarness = this;
+  RenderTarget::setPresentHook(&RegressionHarness::onPresent);
+
+  // Start a reproducible, silent simulation
+  GridManager::setFixedSeed(options.randomSeed);
+  defragSim.setSoundEnabled(false);
+  defragSim.setConsolidationEnabled(options.consolidation);
+  defragSim.reset();
+  defragSim.initialize();
+
+  int mismatches = 0;
+  size_t nextCheckpoint = 0;
+  int lastFrame = options.checkpoints.back();
+  for (int frame = 1; frame <= lastFrame; frame++) {
+    if (frame == options.touchFrame) {
+      defragSim.handleTouch(options.touchX, options.touchY);
+    }
+
+    // Wait for the planner as long as it takes, so the frames do not depend on the planning time
+    while (defragSim.isWaitingForPlanner()) {
+      BackgroundTask::sleepFor(1);
+    }
+
+    // Simulate one tick and render its final state
+    uint32_t startTime = micros();
+    defragSim.update();
+    defragSim.draw(1.0f);
+    uint32_t frameTime = micros() - startTime;
+
+    if (frame != options.checkpoints[nextCheckpoint]) {
+      continue;
+    }
+    nextCheckpoint++;
+
+    // Compare render setups instead of golden frames
+    if (options.differential) {
+      if (!compareRenderSetups(frame)) {
+        mismatches++;
+      }
+      continue;
+    }
+
+    // Compare the frame (or the grid) against its golden hash
+    uint64_t hash = options.hashGrid ? hashGridState() : hashFrame();
+    const char* result;
+    bool matched = false;
+    if (options.record) {
+      goldens[frame] = hash;
+      result = "RECORDED";
+    } else if (goldens.count(frame) == 0) {
+      result = "MISSING";
+      mismatches++;
+    } else if (goldens[frame] != hash) {
+      result = "MISMATCH";
+      mismatches++;
+    } else {
+      result = "OK";
+      matched = true;
+    }
+    printf("frame %5d  hash %016" PRIx64 "  %-8s  %8.3f ms\n", frame, hash, result, frameTime / 1000.0);
+    
+    // Metrics that drifted from the grid fail the frame as well
+    if (options.metrics && !printMetrics() && matched) {
+      mismatches++;
+    }
+
+    if (!options.dumpDirectory.empty() && !dumpFrame(frame)) {
+      fprintf(stderr, "Cannot write frame %d to %s\n", frame, options.dumpDirectory.c_str());
+    }
+  }
+
+  RenderTarget::setPresentHook(nullptr);
+  activeHarness = nullptr;
+
+  if (options.record && !options.differential) {
+    if (!saveGoldens(goldens)) {
+      fprintf(stderr, "Cannot write golden frames to %s\n", options.goldenPath.c_str());
+      return 1;
+    }
+    printf("Recorded %d golden frames to %s\n", static_cast<int>(goldens.size()), options.goldenPath.c_str());
+    return 0;
+  }
+
+  if (options.differential) {
+    printf("%d checkpoints with blocks in flight, %d with explosion debris\n", movingCheckpoints, debrisCheckpoints);
+  }
+  printf("%d of %d frames matched\n",
+         static_cast<int>(options.checkpoints.size()) - mismatches, static_cast<int>(options.checkpoints.size()));
+  return mismatches == 0 ? 0 : 1;
+}
+
+#endif
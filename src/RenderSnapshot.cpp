@@ -0,0 +1,62 @@
+/**
+ * @file RenderSnapshot.cpp
+ * @brief Implementation of render snapshot
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the RenderSnapshot structure which the simulation fills
+ * after its steps and the renderer draws from.
+ */
+
+#include "RenderSnapshot.h"
+
+// Constructor
+RenderSnapshot::RenderSnapshot()
+  : valid(false),
+    columnCount(0),
+    rowCount(0),
+    state(AnimationState::READING_DRIVE_INFO_PHASE1),
+    completionPercentage(0),
+    hitCounter(0),
+    plannedMoveCount(-1),
+    plannedBlockCount(-1),
+    bufferUsedBlocks(0),
+    bufferCapacity(0),
+    diskElapsedTime(0),
+    diskThroughput(0),
+    diskRemainingTime(0),
+    traceSeekDistanceBefore(0),
+    traceSeekDistanceAfter(0),
+    publishTime(0),
+    inputTimestamp(0),
+    interpolate(false) {
+}
+
+// Copy the grid and the explosion debris
+void RenderSnapshot::capture(const GridManager& gridManager, const AnimationManager& animationManager) {
+  columnCount = gridManager.getColumnCount();
+  rowCount = gridManager.getRowCount();
+  blockStates.resize(columnCount * rowCount);
+  movingBlocks.clear();
+  
+  for (int y = 0; y < rowCount; y++) {
+    for (int x = 0; x < columnCount; x++) {
+      const Block& block = gridManager.getBlock(x, y);
+      uint8_t code = static_cast<uint8_t>(block.state);
+      if (block.isMoving) {
+        code |= MOVING_FLAG;
+        MovingBlockSnapshot moving;
+        moving.prevX = FixedPoint::toFloat(block.prevAnimX);
+        moving.prevY = FixedPoint::toFloat(block.prevAnimY);
+        moving.x = FixedPoint::toFloat(block.animX);
+        moving.y = FixedPoint::toFloat(block.animY);
+        movingBlocks.push_back(moving);
+      }
+      blockStates[y * columnCount + x] = code;
+    }
+  }
+  
+  particles = animationManager.getExplosionParticles();
+  valid = true;
+}
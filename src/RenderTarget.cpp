@@ -0,0 +1,278 @@
+/**
+ * @file RenderTarget.cpp
+ * @brief Implementation of drawing target for disk defragmentation visualization
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the RenderTarget class which wraps the off-screen canvas
+ * and translates UI colors into the canvas color format, so that blocks and
+ * UI elements can be drawn into either a direct RGB565 or a palettized canvas.
+ */
+
+#include "RenderTarget.h"
+#include <M5Unified.h>
+
+// Initialize static member
+PresentHook RenderTarget::presentHook = nullptr;
+
+// Get the configured setup
+RenderSetup RenderSetup::configured() {
+  RenderSetup setup;
+  setup.colorDepth = Config::Render::CANVAS_COLOR_DEPTH;
+  setup.bandHeight = Config::Render::BAND_HEIGHT;
+  setup.doubleBuffer = Config::Render::DOUBLE_BUFFER;
+  setup.rasterThreads = Config::Render::RASTER_THREADS;
+  return setup;
+}
+
+// Get the reference setup
+RenderSetup RenderSetup::reference() {
+  RenderSetup setup;
+  setup.colorDepth = 16;
+  setup.bandHeight = 0;
+  setup.doubleBuffer = false;
+  setup.rasterThreads = 1;
+  return setup;
+}
+
+// Constructor
+RenderTarget::RenderTarget(M5Canvas& canvas, M5Canvas& backCanvas)
+  : canvases{&canvas, &backCanvas},
+    canvas(&canvas),
+    originX(0),
+    originY(0) {
+}
+
+// Constructor (single canvas)
+RenderTarget::RenderTarget(M5Canvas& canvas)
+  : canvases{&canvas, &canvas},
+    canvas(&canvas),
+    originX(0),
+    originY(0) {
+}
+
+// Create the canvas sprite with a color depth
+bool RenderTarget::createCanvas(M5Canvas& canvas, int width, int height, int colorDepth, int bandHeight) {
+  // In band rendering mode only one strip of the screen is buffered
+  if (bandHeight > 0 && bandHeight < height) {
+    height = bandHeight;
+  }
+
+  switch (colorDepth) {
+    case 4:
+      canvas.setColorDepth(lgfx::palette_4bit);
+      break;
+    case 8:
+      canvas.setColorDepth(lgfx::palette_8bit);
+      break;
+    default:
+      canvas.setColorDepth(16);
+      break;
+  }
+
+  if (!canvas.createSprite(width, height)) {
+    return false;
+  }
+
+  // Register palette entries (expanded to the panel color format at push time)
+  if (colorDepth <= 8) {
+    canvas.createPalette();
+    for (int i = 0; i < Colors::Palette::COUNT; i++) {
+      uint16_t color = Colors::Palette::ENTRIES[i];
+      uint8_t r = ((color >> 11) & 0x1F) * 255 / 31;
+      uint8_t g = ((color >> 5) & 0x3F) * 255 / 63;
+      uint8_t b = (color & 0x1F) * 255 / 31;
+      canvas.setPaletteColor(i, r, g, b);
+    }
+  }
+
+  return true;
+}
+
+// Create the canvases, falling back to smaller color depths and then to a single canvas
+bool RenderTarget::createCanvases(M5Canvas& canvas, M5Canvas& backCanvas, int width, int height,
+                                  const RenderSetup& setup) {
+  // Try the depth of the setup first, then the smaller palettized ones
+  int colorDepth = setup.colorDepth;
+  while (!createCanvas(canvas, width, height, colorDepth, setup.bandHeight)) {
+    if (colorDepth <= 4) {
+      return false;
+    }
+    colorDepth = (colorDepth > 8) ? 8 : 4;
+  }
+
+  // Both canvases must have the same format: without room for a second one,
+  // pushSprite keeps drawing into the first (single buffering)
+  if (setup.doubleBuffer) {
+    createCanvas(backCanvas, width, height, colorDepth, setup.bandHeight);
+  } else {
+    backCanvas.deleteSprite();
+  }
+  return true;
+}
+
+// Draw into the first canvas again
+void RenderTarget::reset() {
+  canvas = canvases[0];
+  originX = 0;
+  originY = 0;
+}
+
+// Set the screen coordinates mapped to the canvas top-left corner
+void RenderTarget::setOrigin(int x, int y) {
+  originX = x;
+  originY = y;
+}
+
+// Get canvas height
+int RenderTarget::getHeight() const {
+  return canvas->height();
+}
+
+// Get the screen coordinates mapped to the canvas top-left corner
+int RenderTarget::getOriginX() const {
+  return originX;
+}
+
+int RenderTarget::getOriginY() const {
+  return originY;
+}
+
+// Make tileCanvas a view of screen rows [y, y + h) of the current canvas
+bool RenderTarget::createTileCanvas(M5Canvas& tileCanvas, int y, int h) const {
+  int row = y - originY;
+  if (row < 0 || h <= 0 || row + h > canvas->height() || canvas->getBuffer() == nullptr) {
+    return false;
+  }
+
+  // The tile shares the canvas memory, so its pixels land directly in the frame
+  uint32_t rowBytes = canvas->bufferLength() / canvas->height();
+  uint8_t* tileBuffer = static_cast<uint8_t*>(canvas->getBuffer()) + row * rowBytes;
+  tileCanvas.setBuffer(tileBuffer, canvas->width(), h, canvas->getColorDepth());
+  return true;
+}
+
+// Whether a screen-space rectangle intersects the canvas
+bool RenderTarget::isVisible(int x, int y, int w, int h) const {
+  return x + w > originX && x < originX + canvas->width() &&
+         y + h > originY && y < originY + canvas->height();
+}
+
+// Get whether the canvas stores palette indices (its depth may be below the configured one)
+bool RenderTarget::isPalettized() const {
+  return (canvas->getColorDepth() & 0xFF) <= 8;
+}
+
+// Get the palette index of an RGB565 color
+uint8_t RenderTarget::toPaletteIndex(uint16_t color) {
+  for (int i = 0; i < Colors::Palette::COUNT; i++) {
+    if (Colors::Palette::ENTRIES[i] == color) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+// Fill the whole canvas
+// (M5GFX reads a uint16_t color as RGB565 and takes any integer as the index on a palettized canvas;
+//  a uint32_t color would be read as RGB888)
+void RenderTarget::fillScreen(uint16_t color) {
+  if (isPalettized()) {
+    canvas->fillScreen(toPaletteIndex(color));
+  } else {
+    canvas->fillScreen(color);
+  }
+}
+
+// Fill a rectangle
+void RenderTarget::fillRect(int x, int y, int w, int h, uint16_t color) {
+  if (isPalettized()) {
+    canvas->fillRect(x - originX, y - originY, w, h, toPaletteIndex(color));
+  } else {
+    canvas->fillRect(x - originX, y - originY, w, h, color);
+  }
+}
+
+// Draw a rectangle outline
+void RenderTarget::drawRect(int x, int y, int w, int h, uint16_t color) {
+  if (isPalettized()) {
+    canvas->drawRect(x - originX, y - originY, w, h, toPaletteIndex(color));
+  } else {
+    canvas->drawRect(x - originX, y - originY, w, h, color);
+  }
+}
+
+// Draw a line
+void RenderTarget::drawLine(int x0, int y0, int x1, int y1, uint16_t color) {
+  if (isPalettized()) {
+    canvas->drawLine(x0 - originX, y0 - originY, x1 - originX, y1 - originY, toPaletteIndex(color));
+  } else {
+    canvas->drawLine(x0 - originX, y0 - originY, x1 - originX, y1 - originY, color);
+  }
+}
+
+// Set text color
+void RenderTarget::setTextColor(uint16_t color) {
+  if (isPalettized()) {
+    canvas->setTextColor(toPaletteIndex(color));
+  } else {
+    canvas->setTextColor(color);
+  }
+}
+
+// Set text size
+void RenderTarget::setTextSize(int size) {
+  canvas->setTextSize(size);
+}
+
+// Set text cursor position
+void RenderTarget::setCursor(int x, int y) {
+  canvas->setCursor(x - originX, y - originY);
+}
+
+// Print text
+void RenderTarget::print(const char* text) {
+  canvas->print(text);
+}
+
+// Print a number
+void RenderTarget::print(int value) {
+  canvas->print(value);
+}
+
+// Start transferring canvas content to display at the current origin
+void RenderTarget::pushSprite() {
+  // Headless: hand the canvas to the hook instead of the display
+  if (presentHook != nullptr) {
+    presentHook(*canvas, originX, originY);
+    return;
+  }
+  
+  // Fence: the bus must be free before the next transfer starts
+  M5.Display.waitDMA();
+  
+  // Start the transfer (palette indices are expanded to the panel format)
+  if (isPalettized()) {
+    M5.Display.pushImageDMA(originX, originY, canvas->width(), canvas->height(),
+                            canvas->getBuffer(), canvas->getColorDepth(), canvas->getPalette());
+  } else {
+    M5.Display.pushImageDMA(originX, originY, canvas->width(), canvas->height(),
+                            static_cast<const lgfx::swap565_t*>(canvas->getBuffer()));
+  }
+  
+  M5Canvas* other = (canvas == canvases[0]) ? canvases[1] : canvases[0];
+  if (other != canvas && other->getBuffer() != nullptr) {
+    // Draw into the other canvas while this one is being sent.
+    // Its own transfer was completed by the fence above.
+    canvas = other;
+  } else {
+    // Single buffer: the transfer must complete before drawing again
+    M5.Display.waitDMA();
+  }
+}
+
+// Send finished canvases to a hook instead of the display
+void RenderTarget::setPresentHook(PresentHook hook) {
+  presentHook = hook;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file SimulationClock.cpp
+ * @brief Implementation of fixed-timestep simulation clock
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the SimulationClock class which converts elapsed
+ * wall-clock time into fixed simulation ticks, so that animation speed does
+ * not depend on the frame rate, and provides the interpolation factor for
+ * rendering between two ticks.
+ */
+
+#include "SimulationClock.h"
+#include "PlatformCompat.h"
+
+// Constructor
+SimulationClock::SimulationClock()
+  : lastTime(0),
+    accumulator(0),
+    tickCount(0) {
+}
+
+// Restart from the current wall-clock time
+void SimulationClock::reset() {
+  lastTime = micros64();
+  accumulator = 0;
+  tickCount = 0;
+}
+
+// Accumulate the wall-clock time elapsed since the last call
+void SimulationClock::advance() {
+  uint64_t now = micros64();
+  accumulator += now - lastTime;
+  lastTime = now;
+  
+  // Drop time that cannot be caught up, so a long stall does not snowball
+  const uint64_t maxAccumulator = (uint64_t)Config::Animation::TICK_INTERVAL * Config::Animation::MAX_CATCH_UP_TICKS;
+  if (accumulator > maxAccumulator) {
+    accumulator = maxAccumulator;
+  }
+}
+
+// Consume one tick if one is due
+bool SimulationClock::consumeTick() {
+  if (accumulator < Config::Animation::TICK_INTERVAL) {
+    return false;
+  }
+  accumulator -= Config::Animation::TICK_INTERVAL;
+  tickCount++;
+  return true;
+}
+
+// Get the position between the previous and the current tick for rendering
+float SimulationClock::getInterpolationAlpha() const {
+  return (float)accumulator / Config::Animation::TICK_INTERVAL;
+}
+
+// Get the number of ticks consumed since reset
+uint32_t SimulationClock::getTickCount() const {
+  return tickCount;
+}
@@ -12,44 +12,65 @@
 
 #include "Config.h"
 #include "SoundManager.h"
-#include "PlatformCompat.h"
 
 // Constructor
 SoundManager::SoundManager(std::mt19937& rng)
-  : rng(rng) {
-  initialize();
+  : rng(rng),
+    enabled(true) {
 }
 
 // Initialization
 void SoundManager::initialize() {
-  // Set speaker volume
-  M5.Speaker.setVolume(Config::Sound::Seek::SPEAKER_VOLUME);
+  // Set speaker volume (never changed afterwards)
+  M5.Speaker.setVolume(Config::Sound::SPEAKER_VOLUME);
+  
+  // Render the sound effects once
+  sampleCache.initialize();
+  
+  // Start playing queued sound events
+  if (enabled) {
+    audioScheduler.start();
+  }
 }
 
 // Play hard disk seek sound
 void SoundManager::playSeekSound() {
+  if (!enabled || !sampleCache.isInitialized()) {
+    return;
+  }
+  
   // Play a series of short noises with randomized frequency and length
-  std::uniform_int_distribution<int> freqDist(-Config::Sound::Seek::FREQ_VARIATION, Config::Sound::Seek::FREQ_VARIATION);
-  std::uniform_int_distribution<int> durDist(Config::Sound::Seek::MIN_DURATION, Config::Sound::Seek::MAX_DURATION);
+  std::uniform_int_distribution<int> variantDist(0, sampleCache.getSeekClickCount() - 1);
   std::uniform_int_distribution<int> delayDist(0, 2);
   
-  // Play multiple short noises in succession
+  // Queue multiple short noises in succession
   for (int i = 0; i < Config::Sound::Seek::BEEP_COUNT; i++) {
-    // Add significant randomness to the base frequency
-    int freq = Config::Sound::Seek::BASE_FREQ + freqDist(rng);
-    // Also randomize the duration
-    int duration = durDist(rng);
-    // Play the noise
-    M5.Speaker.tone(freq, duration);
+    SoundEvent event;
+    // Pick a random pre-rendered click (frequency and duration differ between variants)
+    event.sample = &sampleCache.getSeekClick(variantDist(rng));
     // Leave a very short interval (this is also slightly randomized)
-    delay(delayDist(rng));
+    event.gapAfter = delayDist(rng);
+    audioScheduler.post(event);
   }
 }
 
 // Play explosion sound
 void SoundManager::playExplosionSound() {
-  // Set speaker volume
-  M5.Speaker.setVolume(Config::Sound::Explosion::SPEAKER_VOLUME);
-  // Play explosion sound
-  M5.Speaker.tone(Config::Sound::Explosion::FREQUENCY, Config::Sound::Explosion::DURATION);
+  if (!enabled || !sampleCache.isInitialized()) {
+    return;
+  }
+  
+  // Queue explosion sound (its loudness is in the samples, the speaker volume stays)
+  SoundEvent event;
+  event.sample = &sampleCache.getExplosion();
+  event.gapAfter = 0;
+  audioScheduler.post(event);
+}
+
+// Enable or disable sound output
+void SoundManager::setEnabled(bool isEnabled) {
+  enabled = isEnabled;
+  if (!enabled) {
+    audioScheduler.stop();
+  }
 }
@@ -0,0 +1,77 @@
+/**
+ * @file SoundSampleCache.cpp
+ * @brief Implementation of pre-synthesized PCM samples of the sound effects
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file implements the SoundSampleCache class which renders the seek click
+ * variants and the explosion into small 16-bit PCM buffers once.
+ */
+
+#include "SoundSampleCache.h"
+
+// Render a square wave tone with a short fade-out
+void SoundSampleCache::synthesizeTone(std::vector<int16_t>& pcm, float frequency, uint32_t duration, float gain) {
+  const uint32_t sampleRate = Config::Sound::Mixer::SAMPLE_RATE;
+  const size_t length = (size_t)sampleRate * duration / 1000;
+  // Fade out over the last millisecond to avoid a click at the end
+  const size_t fadeLength = sampleRate / 1000;
+  const float amplitude = 32767.0f * gain;
+  
+  pcm.resize(length);
+  for (size_t i = 0; i < length; i++) {
+    // Position within the current period (0.0 - 1.0)
+    float phase = i * frequency / sampleRate;
+    phase -= (int)phase;
+    float value = (phase < 0.5f) ? amplitude : -amplitude;
+    
+    size_t remaining = length - i;
+    if (remaining < fadeLength) {
+      value = value * remaining / fadeLength;
+    }
+    pcm[i] = (int16_t)value;
+  }
+}
+
+// Render all samples
+void SoundSampleCache::initialize() {
+  if (isInitialized()) {
+    return;
+  }
+  
+  // Spread the seek click variants over the frequency and duration ranges
+  // (durations are interleaved so that frequency and length do not correlate)
+  const int count = Config::Sound::Seek::VARIANT_COUNT;
+  seekClicks.resize(count);
+  for (int i = 0; i < count; i++) {
+    float frequency = Config::Sound::Seek::BASE_FREQ - Config::Sound::Seek::FREQ_VARIATION +
+                      2.0f * Config::Sound::Seek::FREQ_VARIATION * i / (count - 1);
+    uint32_t duration = Config::Sound::Seek::MIN_DURATION +
+                        (Config::Sound::Seek::MAX_DURATION - Config::Sound::Seek::MIN_DURATION) * ((i * 3) % count) / (count - 1);
+    synthesizeTone(seekClicks[i], frequency, duration, Config::Sound::Seek::GAIN);
+  }
+  
+  synthesizeTone(explosion, Config::Sound::Explosion::FREQUENCY, Config::Sound::Explosion::DURATION,
+                 Config::Sound::Explosion::GAIN);
+}
+
+// Get whether the samples have been rendered
+bool SoundSampleCache::isInitialized() const {
+  return !explosion.empty();
+}
+
+// Get the number of seek click variants
+int SoundSampleCache::getSeekClickCount() const {
+  return seekClicks.size();
+}
+
+// Get a seek click variant
+const std::vector<int16_t>& SoundSampleCache::getSeekClick(int index) const {
+  return seekClicks[index];
+}
+
+// Get the explosion sound
+const std::vector<int16_t>& SoundSampleCache::getExplosion() const {
+  return explosion;
+}
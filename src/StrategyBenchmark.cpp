@@ -0,0 +1,724 @@
+/**
+ * @file StrategyBenchmark.cpp
+ * @brief Implementation of native benchmark comparing the defrag strategies
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ *
+ * This file implements the StrategyBenchmark class which runs every defrag
+ * strategy on the same seeded drive layouts and reports the number of moves,
+ * the blocks moved, the planning CPU time, the contiguity of the result and
+ * the change of the head travel of the access trace,
+ * then how the simulated defrag time scales with the number of heads, and
+ * the cost of the I/O with each policy, queue depth and staging buffer,
+ * charged to the timing model of the drive.
+ */
+
+#include "StrategyBenchmark.h"
+
+#ifndef ARDUINO
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <memory>
+#include "Config.h"
+#include "FileManager.h"
+#include "DefragStrategy.h"
+#include "MultiHeadPlanner.h"
+#include "AnimationManager.h"
+#include "IoScheduler.h"
+#include "CopyEngine.h"
+#include "DiskModel.h"
+#include "AccessTrace.h"
+#include "ConsolidationPlanner.h"
+
+// All strategies, in the order they are reported
+static const DefragStrategyType ALL_STRATEGIES[] = {
+  DefragStrategyType::FIRST_FIT,
+  DefragStrategyType::BEST_FIT,
+  DefragStrategyType::LARGEST_FILE_FIRST,
+  DefragStrategyType::MOST_FRAGMENTED_FIRST,
+  DefragStrategyType::SLIDING_COMPACTION,
+  DefragStrategyType::WHOLE_DISK_COMPACTION,
+  DefragStrategyType::HOT_COLD_COMPACTION
+};
+
+// Numbers of heads compared by default
+static const int DEFAULT_HEAD_COUNTS[] = {1, 2, 4, 8};
+
+// I/O queue depths compared by default
+static const int DEFAULT_QUEUE_DEPTHS[] = {1, 4, 16, 32};
+
+// Staging buffer sizes compared by default (in blocks)
+static const int DEFAULT_BUFFER_SIZES[] = {0, 8, 32, 128};
+
+// I/O policies, in the order they are reported
+static const IoPolicy ALL_IO_POLICIES[] = {
+  IoPolicy::FIFO,
+  IoPolicy::ELEVATOR,
+  IoPolicy::NCQ
+};
+
+// Parse comma-separated counts of at least minimum (returns false if the list is invalid)
+static bool parseCounts(const char* value, int minimum, std::vector<int>& counts) {
+  counts.clear();
+  const char* next = value;
+  while (*next != '\0') {
+    char* end = nullptr;
+    long count = strtol(next, &end, 10);
+    if (end == next || count < minimum || (*end != ',' && *end != '\0')) {
+      return false;
+    }
+    counts.push_back(count);
+    next = (*end == ',') ? end + 1 : end;
+  }
+  return !counts.empty();
+}
+
+// Constructor (default settings: all strategies, 1 to 8 heads, queue depths 1 to 32, buffers of 0 to 128 blocks)
+BenchmarkOptions::BenchmarkOptions()
+  : firstSeed(1),
+    layoutCount(20),
+    width(320),
+    height(240),
+    headCounts(std::begin(DEFAULT_HEAD_COUNTS), std::end(DEFAULT_HEAD_COUNTS)),
+    queueDepths(std::begin(DEFAULT_QUEUE_DEPTHS), std::end(DEFAULT_QUEUE_DEPTHS)),
+    bufferSizes(std::begin(DEFAULT_BUFFER_SIZES), std::end(DEFAULT_BUFFER_SIZES)),
+    validate(false) {
+}
+
+// Constructor
+BenchmarkResult::BenchmarkResult()
+  : moveCount(0),
+    movedBlockCount(0),
+    planningTime(0.0),
+    diskTime(0),
+    fileCount(0),
+    contiguousFileCount(0),
+    dataBlockCount(0),
+    compactedBlockCount(0),
+    freeRunCount(0),
+    consolidatedFreeRunCount(0),
+    traceSeekBefore(0),
+    traceSeekAfter(0) {
+}
+
+// Constructor
+HeadScalingResult::HeadScalingResult()
+  : moveCount(0),
+    movedBlockCount(0),
+    crossRegionMoveCount(0),
+    conflictCount(0),
+    defragTicks(0),
+    diskTime(0),
+    fileCount(0),
+    contiguousFileCount(0) {
+}
+
+// Constructor
+CopyResult::CopyResult()
+  : batchCount(0),
+    requestCount(0),
+    operationCount(0),
+    headTravel(0),
+    diskTime(0),
+    transferredBytes(0) {
+}
+
+// Constructor
+StrategyBenchmark::StrategyBenchmark(const BenchmarkOptions& options)
+  : options(options) {
+}
+
+// Parse command line arguments into options
+bool StrategyBenchmark::parseArguments(int argc, char** argv, BenchmarkOptions& options) {
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+    bool valid = (value != nullptr);
+
+    // The only option without a value
+    if (strcmp(arg, "--validate") == 0) {
+      options.validate = true;
+      continue;
+    }
+
+    if (strcmp(arg, "--seed") == 0 && valid) {
+      options.firstSeed = strtoul(value, nullptr, 10);
+    } else if (strcmp(arg, "--layouts") == 0 && valid) {
+      options.layoutCount = atoi(value);
+      valid = options.layoutCount > 0;
+    } else if (strcmp(arg, "--size") == 0 && valid) {
+      valid = sscanf(value, "%dx%d", &options.width, &options.height) == 2;
+    } else if (strcmp(arg, "--strategy") == 0 && valid) {
+      // Strategies are named as they are reported
+      valid = false;
+      for (DefragStrategyType type : ALL_STRATEGIES) {
+        if (strcmp(DefragStrategy::create(type)->getName(), value) == 0) {
+          options.strategies.push_back(type);
+          valid = true;
+        }
+      }
+    } else if (strcmp(arg, "--heads") == 0 && valid) {
+      valid = parseCounts(value, 1, options.headCounts);
+    } else if (strcmp(arg, "--depths") == 0 && valid) {
+      valid = parseCounts(value, 1, options.queueDepths);
+    } else if (strcmp(arg, "--buffers") == 0 && valid) {
+      valid = parseCounts(value, 0, options.bufferSizes);
+    } else {
+      valid = false;
+    }
+
+    if (!valid) {
+      fprintf(stderr,
+              "Usage: %s [--seed N] [--layouts N] [--size WxH] [--strategy NAME]...\n"
+              "          [--heads N,N,...] [--depths N,N,...] [--buffers N,N,...] [--validate]\n"
+              "Strategies:", argv[0]);
+      for (DefragStrategyType type : ALL_STRATEGIES) {
+        fprintf(stderr, " %s", DefragStrategy::create(type)->getName());
+      }
+      fprintf(stderr, "\n");
+      return false;
+    }
+    i++;
+  }
+
+  if (options.strategies.empty()) {
+    options.strategies.assign(std::begin(ALL_STRATEGIES), std::end(ALL_STRATEGIES));
+  }
+  return true;
+}
+
+// Create a drive layout as it is after reading drive information
+void StrategyBenchmark::createLayout(uint32_t seed, GridManager& gridManager) {
+  GridManager::setFixedSeed(seed);
+  gridManager = GridManager();
+  // Assigns the file IDs (optimized blocks get IDs of their own)
+  FileManager fileManager(gridManager);
+
+  for (int y = 0; y < gridManager.getRowCount(); y++) {
+    for (int x = 0; x < gridManager.getColumnCount(); x++) {
+      Block& block = gridManager.getBlock(x, y);
+      block.updateStateInDriveInfoPhase1();
+      block.updateStateInDriveInfoPhase2();
+    }
+  }
+  gridManager.rebuildFragmentationMetrics();
+}
+
+// Run a strategy on a layout and add its results
+void StrategyBenchmark::runStrategy(DefragStrategyType type, GridManager& gridManager, BenchmarkResult& result) {
+  // The file manager works on the layout as it is (its own ID assignment is overwritten)
+  GridManager grid;
+  FileManager fileManager(grid);
+  grid = gridManager;
+
+  std::vector<PlannedMove> files;
+  fileManager.collectUnoptimizedFiles(files);
+  std::vector<int> fileIDs;
+  for (const auto &file : files) {
+    fileIDs.push_back(file.fileID);
+  }
+
+  // Head travel of the access trace on the layout as it is
+  AccessTrace accessTrace;
+  accessTrace.generate(grid);
+  result.traceSeekBefore += accessTrace.replay(grid).seekDistance;
+
+  // Plan every move (each strategy applies its moves to the grid as it plans them)
+  std::unique_ptr<DefragStrategy> strategy = DefragStrategy::create(type);
+  std::clock_t startTime = std::clock();
+  strategy->begin(grid, fileManager);
+  PlannedMove move;
+  std::vector<PlannedMove> moves;
+  while (strategy->planNextMove(grid, fileManager, move)) {
+    if (!move.targetPositions.empty()) {
+      result.moveCount++;
+      result.movedBlockCount += move.targetPositions.size();
+      moves.push_back(move);
+    }
+  }
+  result.planningTime += static_cast<double>(std::clock() - startTime) / CLOCKS_PER_SEC;
+
+  // Time the copies take on the drive, as the defrag loop copies them
+  CopyResult copyResult;
+  runCopy(Config::Copy::STAGING_BLOCKS, grid, moves, copyResult);
+  result.diskTime += copyResult.diskTime;
+
+  // The same trace on the defragmented layout
+  result.traceSeekAfter += accessTrace.replay(grid).seekDistance;
+
+  measureLayout(grid, fileIDs, result);
+
+  // The free space after the consolidation pass that follows (skipped after compaction, as in the simulator)
+  if (!DefragStrategy::compactsFreeSpace(type)) {
+    ConsolidationPlanner consolidationPlanner(grid);
+    consolidationPlanner.plan(moves);
+    for (const auto &consolidationMove : moves) {
+      fileManager.completePlannedMove(consolidationMove);
+    }
+  }
+  result.consolidatedFreeRunCount += grid.getFragmentationMetrics().getSummary().freeExtentCount;
+}
+
+// Measure the contiguity of a defragmented layout and add it to the results
+void StrategyBenchmark::measureLayout(const GridManager& gridManager, const std::vector<int>& fileIDs,
+                                      BenchmarkResult& result) {
+  // Fixed blocks end a run of free cells but do not count against compaction
+  bool seenFree = false;
+  bool inFreeRun = false;
+  for (int y = 0; y < gridManager.getRowCount(); y++) {
+    for (int x = 0; x < gridManager.getColumnCount(); x++) {
+      const Block& block = gridManager.getBlock(x, y);
+      if (block.state == BlockState::FIXED || block.state == BlockState::BAD) {
+        inFreeRun = false;
+        continue;
+      }
+
+      if (block.state == BlockState::FREE) {
+        // A run of free cells starts here
+        if (!inFreeRun) {
+          result.freeRunCount++;
+        }
+        seenFree = true;
+        inFreeRun = true;
+      } else {
+        result.dataBlockCount++;
+        if (!seenFree) {
+          result.compactedBlockCount++;
+        }
+        inFreeRun = false;
+      }
+    }
+  }
+
+  result.fileCount += fileIDs.size();
+  result.contiguousFileCount += countContiguousFiles(gridManager, fileIDs);
+}
+
+// Count the files whose blocks occupy consecutive cells
+int StrategyBenchmark::countContiguousFiles(const GridManager& gridManager, const std::vector<int>& fileIDs) {
+  std::map<int, std::vector<int>> fileCells;
+  for (int fileID : fileIDs) {
+    fileCells[fileID];
+  }
+  for (int y = 0; y < gridManager.getRowCount(); y++) {
+    for (int x = 0; x < gridManager.getColumnCount(); x++) {
+      const Block& block = gridManager.getBlock(x, y);
+      std::map<int, std::vector<int>>::iterator file = fileCells.find(block.fileID);
+      if (file != fileCells.end() && FragmentationMetrics::isFileState(block.state)) {
+        file->second.push_back(y * gridManager.getColumnCount() + x);
+      }
+    }
+  }
+
+  int contiguousFileCount = 0;
+  for (const auto &file : fileCells) {
+    const std::vector<int>& cells = file.second;
+    bool contiguous = true;
+    for (size_t i = 1; i < cells.size() && contiguous; i++) {
+      contiguous = cells[i] == cells[i - 1] + 1;
+    }
+    if (contiguous) {
+      contiguousFileCount++;
+    }
+  }
+  return contiguousFileCount;
+}
+
+// Plan a layout with a number of heads, replay the moves through the animation and add the results
+void StrategyBenchmark::runHeads(int headCount, const GridManager& gridManager, HeadScalingResult& result) {
+  // The file manager works on the layout as it is (its own ID assignment is overwritten)
+  GridManager grid;
+  FileManager fileManager(grid);
+  grid = gridManager;
+
+  std::vector<PlannedMove> files;
+  fileManager.collectUnoptimizedFiles(files);
+  std::vector<int> fileIDs;
+  for (const auto &file : files) {
+    fileIDs.push_back(file.fileID);
+  }
+
+  // Plan every move, taking them from the heads in turn while their workers plan ahead
+  MultiHeadPlanner planner(headCount);
+  std::vector<std::vector<PlannedMove>> headMoves(headCount);
+  planner.begin(grid, fileManager);
+  std::vector<bool> headsDone(headCount, false);
+  int remainingHeads = headCount;
+  while (remainingHeads > 0) {
+    for (int head = 0; head < headCount; head++) {
+      PlannedMove move;
+      if (headsDone[head]) {
+        continue;
+      }
+      if (planner.takeNextMove(head, move)) {
+        headMoves[head].push_back(move);
+      } else {
+        headsDone[head] = true;
+        remainingHeads--;
+      }
+    }
+  }
+
+  // Time the copies take on the drive: each head has its own actuator, so the drive is busy as long as the busiest head
+  uint64_t diskTime = 0;
+  for (const auto &moves : headMoves) {
+    CopyResult copyResult;
+    runCopy(Config::Copy::STAGING_BLOCKS, grid, moves, copyResult);
+    diskTime = std::max(diskTime, copyResult.diskTime);
+  }
+  result.diskTime += diskTime;
+
+  // Replay the moves as the defrag loop does: every idle head starts its next file at each defrag step
+  AnimationManager animationManager(grid);
+  std::vector<size_t> nextMoves(headCount, 0);
+  std::vector<PlannedMove> activeMoves(headCount);
+  uint64_t now = 0;
+  bool finished = false;
+  while (!finished) {
+    now += Config::Animation::TICK_INTERVAL;
+    result.defragTicks++;
+    animationManager.incrementDefragStep();
+    bool isDefragStep = animationManager.getDefragStep() % Config::Animation::DEFRAG_STEP_INTERVAL == 0;
+
+    finished = true;
+    for (int head = 0; head < headCount; head++) {
+      if (!fileManager.isMoveFinished(activeMoves[head])) {
+        finished = false;
+        continue;
+      }
+      if (nextMoves[head] >= headMoves[head].size()) {
+        continue;
+      }
+      finished = false;
+      if (!isDefragStep) {
+        continue;
+      }
+
+      PlannedMove& move = activeMoves[head];
+      move = headMoves[head][nextMoves[head]++];
+      if (!move.targetPositions.empty()) {
+        result.moveCount++;
+        result.movedBlockCount += move.targetPositions.size();
+        if (planner.getRegionHead(move.targetPositions[0].first, move.targetPositions[0].second) != head) {
+          result.crossRegionMoveCount++;
+        }
+      }
+
+      // Free space claimed by a head must still be free when its move starts
+      for (const auto &position : move.targetPositions) {
+        if (grid.getBlock(position.first, position.second).state != BlockState::FREE) {
+          result.conflictCount++;
+          break;
+        }
+      }
+      fileManager.applyPlannedMove(move, now);
+    }
+
+    animationManager.updateBlocksInDefragmenting(now);
+  }
+
+  // Whether each file ended up in one piece
+  result.fileCount += fileIDs.size();
+  result.contiguousFileCount += countContiguousFiles(grid, fileIDs);
+}
+
+// Replay the moves of a strategy on a layout and print every problem found
+int StrategyBenchmark::validateStrategy(DefragStrategyType type, uint32_t seed, const GridManager& gridManager,
+                                        long& moveCount) {
+  const char* name = DefragStrategy::create(type)->getName();
+  std::vector<PlannedMove> moves;
+  collectMoves(type, gridManager, moves);
+
+  // The moves are replayed on the layout as it was before planning
+  GridManager grid;
+  FileManager fileManager(grid);
+  grid = gridManager;
+  std::map<int, int> blockCountsBefore;
+  for (int y = 0; y < grid.getRowCount(); y++) {
+    for (int x = 0; x < grid.getColumnCount(); x++) {
+      const Block& block = grid.getBlock(x, y);
+      if (FragmentationMetrics::isFileState(block.state)) {
+        blockCountsBefore[block.fileID]++;
+      }
+    }
+  }
+
+  int problemCount = 0;
+  std::vector<int> keptFileIDs;  // Files optimized where they are (moves without targets)
+  for (const auto &move : moves) {
+    if (move.targetPositions.empty()) {
+      for (const auto &position : move.fileBlocks) {
+        keptFileIDs.push_back(grid.getBlock(position.first, position.second).fileID);
+      }
+      fileManager.completePlannedMove(move);
+      continue;
+    }
+
+    // Block k may only write to a free cell, or to a cell the move reads before it (a shift over its own blocks)
+    moveCount++;
+    for (size_t k = 0; k < move.fileBlocks.size(); k++) {
+      const std::pair<int, int>& source = move.fileBlocks[k];
+      const std::pair<int, int>& target = move.targetPositions[k];
+      if (!FragmentationMetrics::isFileState(grid.getBlock(source.first, source.second).state)) {
+        printf("seed %u %s: file %d reads (%d,%d), which holds no data\n",
+               seed, name, move.fileID, source.first, source.second);
+        problemCount++;
+      }
+      bool readBefore = std::find(move.fileBlocks.begin(), move.fileBlocks.begin() + k + 1, target) !=
+                        move.fileBlocks.begin() + k + 1;
+      if (grid.getBlock(target.first, target.second).state != BlockState::FREE && !readBefore) {
+        printf("seed %u %s: file %d overwrites (%d,%d)\n", seed, name, move.fileID, target.first, target.second);
+        problemCount++;
+      }
+    }
+    fileManager.completePlannedMove(move);
+  }
+
+  // Every block of every file is still there, and fixed blocks have not moved
+  std::map<int, int> blockCountsAfter;
+  for (int y = 0; y < grid.getRowCount(); y++) {
+    for (int x = 0; x < grid.getColumnCount(); x++) {
+      const Block& block = grid.getBlock(x, y);
+      BlockState stateBefore = gridManager.getBlock(x, y).state;
+      if (FragmentationMetrics::isFileState(block.state)) {
+        blockCountsAfter[block.fileID]++;
+      }
+      if ((stateBefore == BlockState::FIXED || stateBefore == BlockState::BAD) && block.state != stateBefore) {
+        printf("seed %u %s: fixed block (%d,%d) changed\n", seed, name, x, y);
+        problemCount++;
+      }
+      if (block.state != BlockState::OPTIMIZED && FragmentationMetrics::isFileState(block.state)) {
+        printf("seed %u %s: block (%d,%d) was never defragmented\n", seed, name, x, y);
+        problemCount++;
+      }
+    }
+  }
+  if (blockCountsAfter != blockCountsBefore) {
+    printf("seed %u %s: blocks of files were lost or duplicated\n", seed, name);
+    problemCount++;
+  }
+
+  // Every file that moved is in consecutive cells
+  std::vector<int> movedFileIDs;
+  for (const auto &move : moves) {
+    if (!move.targetPositions.empty() &&
+        std::find(keptFileIDs.begin(), keptFileIDs.end(), move.fileID) == keptFileIDs.end() &&
+        std::find(movedFileIDs.begin(), movedFileIDs.end(), move.fileID) == movedFileIDs.end()) {
+      movedFileIDs.push_back(move.fileID);
+    }
+  }
+  int fragmentedCount = movedFileIDs.size() - countContiguousFiles(grid, movedFileIDs);
+  if (fragmentedCount > 0) {
+    printf("seed %u %s: %d moved files are not contiguous\n", seed, name, fragmentedCount);
+    problemCount++;
+  }
+  return problemCount;
+}
+
+// Validate every strategy on every layout
+int StrategyBenchmark::runValidation(const std::vector<GridManager>& layouts) {
+  printf("%-22s %8s %10s %9s\n", "strategy", "layouts", "moves", "problems");
+  int totalProblemCount = 0;
+  for (DefragStrategyType type : options.strategies) {
+    long moveCount = 0;
+    int problemCount = 0;
+    for (size_t i = 0; i < layouts.size(); i++) {
+      problemCount += validateStrategy(type, options.firstSeed + i, layouts[i], moveCount);
+    }
+    printf("%-22s %8d %10ld %9d\n", DefragStrategy::create(type)->getName(), (int)layouts.size(), moveCount,
+           problemCount);
+    totalProblemCount += problemCount;
+  }
+  return (totalProblemCount > 0) ? 1 : 0;
+}
+
+// Plan all moves of a strategy on a layout
+void StrategyBenchmark::collectMoves(DefragStrategyType type, const GridManager& gridManager,
+                                     std::vector<PlannedMove>& moves) {
+  GridManager grid;
+  FileManager fileManager(grid);
+  grid = gridManager;
+
+  std::unique_ptr<DefragStrategy> strategy = DefragStrategy::create(type);
+  strategy->begin(grid, fileManager);
+  PlannedMove move;
+  moves.clear();
+  while (strategy->planNextMove(grid, fileManager, move)) {
+    moves.push_back(move);
+  }
+}
+
+// Measure the head travel of servicing moves with an I/O policy and queue depth
+uint64_t StrategyBenchmark::measureHeadTravel(IoPolicy policy, int queueDepth, const GridManager& gridManager,
+                                              const std::vector<PlannedMove>& moves) {
+  IoScheduler ioScheduler(policy, queueDepth);
+  ioScheduler.reset(gridManager.getColumnCount(), gridManager.getRowCount());
+  for (const auto &plannedMove : moves) {
+    PlannedMove move = plannedMove;
+    ioScheduler.schedule(move);
+  }
+  return ioScheduler.getHeadTravel();
+}
+
+// Copy moves through a staging buffer with the configured I/O policy and queue depth
+void StrategyBenchmark::runCopy(int bufferSize, const GridManager& gridManager, const std::vector<PlannedMove>& moves,
+                                CopyResult& result) {
+  CopyEngine copyEngine(bufferSize);
+  IoScheduler ioScheduler;
+  copyEngine.reset(gridManager.getColumnCount(), gridManager.getRowCount());
+  ioScheduler.reset(gridManager.getColumnCount(), gridManager.getRowCount());
+  PlannedMove batch;
+  size_t nextMove = 0;
+
+  // The same loop as the defrag loop, without waiting for the blocks to arrive
+  while (true) {
+    while (copyEngine.hasRoom() && nextMove < moves.size()) {
+      const PlannedMove& move = moves[nextMove++];
+      if (!move.targetPositions.empty()) {
+        copyEngine.addMove(move);
+      }
+    }
+    if (!copyEngine.takeBatch(batch)) {
+      break;
+    }
+    ioScheduler.schedule(batch, copyEngine.isStaged());
+    result.batchCount++;
+  }
+
+  result.requestCount += ioScheduler.getRequestCount();
+  result.operationCount += ioScheduler.getOperationCount();
+  result.headTravel += ioScheduler.getHeadTravel();
+  result.diskTime += ioScheduler.getDiskModel().getElapsedTime();
+  result.transferredBytes += ioScheduler.getDiskModel().getTransferredBytes();
+}
+
+// Run the benchmark and print the comparison
+int StrategyBenchmark::run() {
+  Config::getInstance()->initialize(options.width, options.height);
+
+  // Every strategy plans the same layouts
+  std::vector<GridManager> layouts(options.layoutCount);
+  for (int i = 0; i < options.layoutCount; i++) {
+    createLayout(options.firstSeed + i, layouts[i]);
+  }
+
+  if (options.validate) {
+    printf("validating %d layouts (seeds %u-%u), grid %dx%d\n",
+           options.layoutCount, options.firstSeed, options.firstSeed + options.layoutCount - 1,
+           Config::getGridCols(), Config::getGridRows());
+    return runValidation(layouts);
+  }
+
+  printf("%d layouts (seeds %u-%u), grid %dx%d, averages per layout\n",
+         options.layoutCount, options.firstSeed, options.firstSeed + options.layoutCount - 1,
+         Config::getGridCols(), Config::getGridRows());
+  printf("%-22s %8s %8s %10s %8s %11s %10s %10s %12s %8s\n",
+         "strategy", "moves", "blocks", "plan ms", "disk s", "contiguous", "compacted", "free runs", "consolidated",
+         "seek");
+
+  for (DefragStrategyType type : options.strategies) {
+    BenchmarkResult result;
+    for (auto &layout : layouts) {
+      runStrategy(type, layout, result);
+    }
+
+    double layoutCount = options.layoutCount;
+    printf("%-22s %8.1f %8.1f %10.3f %8.2f %10.1f%% %9.1f%% %10.1f %12.1f %+7.1f%%\n",
+           DefragStrategy::create(type)->getName(),
+           result.moveCount / layoutCount,
+           result.movedBlockCount / layoutCount,
+           result.planningTime * 1000.0 / layoutCount,
+           result.diskTime / 1000000.0 / layoutCount,
+           result.fileCount > 0 ? result.contiguousFileCount * 100.0 / result.fileCount : 100.0,
+           result.dataBlockCount > 0 ? result.compactedBlockCount * 100.0 / result.dataBlockCount : 100.0,
+           result.freeRunCount / layoutCount,
+           result.consolidatedFreeRunCount / layoutCount,
+           result.traceSeekBefore > 0 ?
+               ((double)result.traceSeekAfter - (double)result.traceSeekBefore) * 100.0 / result.traceSeekBefore : 0.0);
+  }
+
+  // Defrag time with several heads (speedups relative to the first number of heads)
+  printf("\n%-6s %8s %8s %8s %10s %11s %9s %8s %8s %8s %8s\n",
+         "heads", "moves", "blocks", "cross", "conflicts", "contiguous", "defrag s", "files/s", "speedup", "disk s", "disk x");
+  long firstDefragTicks = 0;
+  uint64_t firstDiskTime = 0;
+  for (int headCount : options.headCounts) {
+    HeadScalingResult result;
+    for (auto &layout : layouts) {
+      runHeads(headCount, layout, result);
+    }
+    if (firstDefragTicks == 0) {
+      firstDefragTicks = result.defragTicks;
+      firstDiskTime = result.diskTime;
+    }
+
+    double layoutCount = options.layoutCount;
+    double defragTime = result.defragTicks * (double)Config::Animation::TICK_INTERVAL / 1000000.0;
+    printf("%-6d %8.1f %8.1f %8.1f %10ld %10.1f%% %9.1f %8.2f %7.2fx %8.2f %7.2fx\n",
+           headCount,
+           result.moveCount / layoutCount,
+           result.movedBlockCount / layoutCount,
+           result.crossRegionMoveCount / layoutCount,
+           result.conflictCount,
+           result.fileCount > 0 ? result.contiguousFileCount * 100.0 / result.fileCount : 100.0,
+           defragTime / layoutCount,
+           defragTime > 0.0 ? result.moveCount / defragTime : 0.0,
+           result.defragTicks > 0 ? (double)firstDefragTicks / result.defragTicks : 0.0,
+           result.diskTime / 1000000.0 / layoutCount,
+           result.diskTime > 0 ? (double)firstDiskTime / result.diskTime : 0.0);
+  }
+
+  // Head travel of the configured strategy's moves with each I/O policy and queue depth
+  std::vector<std::vector<PlannedMove>> layoutMoves(layouts.size());
+  for (size_t i = 0; i < layouts.size(); i++) {
+    collectMoves(Config::Planner::STRATEGY, layouts[i], layoutMoves[i]);
+  }
+  printf("\nhead travel of %s moves (clusters per layout)\n%-10s",
+         DefragStrategy::create(Config::Planner::STRATEGY)->getName(), "policy");
+  for (int queueDepth : options.queueDepths) {
+    printf(" %9s%-3d", "depth ", queueDepth);
+  }
+  printf("\n");
+  for (IoPolicy policy : ALL_IO_POLICIES) {
+    printf("%-10s", IoScheduler::getPolicyName(policy));
+    for (int queueDepth : options.queueDepths) {
+      uint64_t headTravel = 0;
+      for (size_t i = 0; i < layouts.size(); i++) {
+        headTravel += measureHeadTravel(policy, queueDepth, layouts[i], layoutMoves[i]);
+      }
+      printf(" %12.0f", (double)headTravel / options.layoutCount);
+    }
+    printf("\n");
+  }
+
+  // I/O operations of copying the same moves through staging buffers of each size
+  printf("\ncopy through a staging buffer (%s, depth %d, %s, per layout)\n%-10s %8s %10s %11s %12s %8s %8s\n",
+         IoScheduler::getPolicyName(Config::Io::POLICY), Config::Io::QUEUE_DEPTH,
+         DiskModel::create(Config::Disk::MODEL, 0)->getName(),
+         "buffer", "batches", "requests", "operations", "head travel", "disk s", "MB/s");
+  for (int bufferSize : options.bufferSizes) {
+    CopyResult result;
+    for (size_t i = 0; i < layouts.size(); i++) {
+      runCopy(bufferSize, layouts[i], layoutMoves[i], result);
+    }
+
+    double layoutCount = options.layoutCount;
+    printf("%-10d %8.1f %10.1f %11.1f %12.0f %8.2f %8.1f\n",
+           bufferSize,
+           result.batchCount / layoutCount,
+           result.requestCount / layoutCount,
+           result.operationCount / layoutCount,
+           result.headTravel / layoutCount,
+           result.diskTime / 1000000.0 / layoutCount,
+           result.diskTime > 0 ? (double)result.transferredBytes / result.diskTime : 0.0);
+  }
+  return 0;
+}
+
+#endif
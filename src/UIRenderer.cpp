@@ -12,6 +12,9 @@
 
 #include "UIRenderer.h"
 #include <M5Unified.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 // Constructor
 UIRenderer::UIRenderer()
@@ -19,57 +22,117 @@ UIRenderer::UIRenderer()
     completionPercentage(0),
     screenWidth(0),
     screenHeight(0),
-    hitCounter(0) {
+    hitCounter(0),
+    plannedMoveCount(-1),
+    plannedBlockCount(-1),
+    bufferUsedBlocks(0),
+    bufferCapacity(0),
+    diskElapsedTime(0),
+    diskThroughput(0),
+    diskRemainingTime(0),
+    traceSeekDistanceBefore(0),
+    traceSeekDistanceAfter(0),
+    turboFactor(1),
+    inputLatency(0),
+    interpolationAlpha(1.0f),
+    snapshot(nullptr),
+    target(canvas, backCanvas) {
 }
 
 // Initialization
 void UIRenderer::initialize() {
   // Get and save the screen width once
-  screenWidth = M5.Display.width();
+  screenWidth = Config::getScreenWidth();
 
   // Get and save the screen height once
-  screenHeight = M5.Display.height();
+  screenHeight = Config::getScreenHeight();
 
-  // Initialize hit counter
-  hitCounter = 0;
+  // Start raster worker threads (kept across resets)
+  startRasterThreads(Config::Render::RASTER_THREADS);
+}
+
+// Start the raster worker threads
+void UIRenderer::startRasterThreads(int threadCount) {
+#ifndef ARDUINO
+  if (rasterPool.getThreadCount() != threadCount) {
+    rasterPool.start(threadCount);
+    tileCanvases.clear();
+    for (int i = 0; i < rasterPool.getThreadCount(); i++) {
+      tileCanvases.push_back(std::unique_ptr<M5Canvas>(new M5Canvas()));
+    }
+  }
+#else
+  (void)threadCount;
+#endif
+}
+
+// Create the canvases and raster threads of a setup anew
+bool UIRenderer::applyRenderSetup(const RenderSetup& setup) {
+  target.reset();
+  startRasterThreads(setup.rasterThreads);
+  return RenderTarget::createCanvases(canvas, backCanvas, screenWidth, screenHeight, setup);
 }
 
 // Draw UI elements
 void UIRenderer::drawUI() {
   // Title bar
-  canvas.fillRect(0, 0, screenWidth, Config::TITLE_BAR_HEIGHT, Colors::UI::TITLE_BAR_BACK);
+  target.fillRect(0, 0, screenWidth, Config::TITLE_BAR_HEIGHT, Colors::UI::TITLE_BAR_BACK);
   
   // Buttons in the title bar
   // Close button
-  canvas.fillRect(screenWidth - 18, 3, 15, 14, Colors::UI::BUTTON_BACK);
-  canvas.drawLine(screenWidth - 18, 3, screenWidth - 4, 3, Colors::UI::BUTTON_LIGHT);      // Drawing top edge (white)
-  canvas.drawLine(screenWidth - 18, 3, screenWidth - 18, 16, Colors::UI::BUTTON_LIGHT);    // Drawing left edge (white)
-  canvas.drawLine(screenWidth - 4, 3, screenWidth - 4, 16, Colors::UI::BUTTON_SHADOW);     // Drawing right edge (black)
-  canvas.drawLine(screenWidth - 18, 16, screenWidth - 4, 16, Colors::UI::BUTTON_SHADOW);   // Drawing bottom edge (black)
-  canvas.drawLine(screenWidth - 15, 7, screenWidth - 7, 11, Colors::UI::BUTTON_TEXT);      // Drawing ×
-  canvas.drawLine(screenWidth - 15, 11, screenWidth - 7, 7, Colors::UI::BUTTON_TEXT);      // Drawing ×
+  target.fillRect(screenWidth - 18, 3, 15, 14, Colors::UI::BUTTON_BACK);
+  target.drawLine(screenWidth - 18, 3, screenWidth - 4, 3, Colors::UI::BUTTON_LIGHT);      // Drawing top edge (white)
+  target.drawLine(screenWidth - 18, 3, screenWidth - 18, 16, Colors::UI::BUTTON_LIGHT);    // Drawing left edge (white)
+  target.drawLine(screenWidth - 4, 3, screenWidth - 4, 16, Colors::UI::BUTTON_SHADOW);     // Drawing right edge (black)
+  target.drawLine(screenWidth - 18, 16, screenWidth - 4, 16, Colors::UI::BUTTON_SHADOW);   // Drawing bottom edge (black)
+  target.drawLine(screenWidth - 15, 7, screenWidth - 7, 11, Colors::UI::BUTTON_TEXT);      // Drawing ×
+  target.drawLine(screenWidth - 15, 11, screenWidth - 7, 7, Colors::UI::BUTTON_TEXT);      // Drawing ×
   
   // Maximize button
-  canvas.fillRect(screenWidth - 36, 3, 15, 14, Colors::UI::BUTTON_BACK);
-  canvas.drawLine(screenWidth - 36, 3, screenWidth - 22, 3, Colors::UI::BUTTON_LIGHT);     // Drawing top edge (white)
-  canvas.drawLine(screenWidth - 36, 3, screenWidth - 36, 16, Colors::UI::BUTTON_LIGHT);    // Drawing left edge (white)
-  canvas.drawLine(screenWidth - 22, 3, screenWidth - 22, 16, Colors::UI::BUTTON_SHADOW);   // Drawing right edge (black)
-  canvas.drawLine(screenWidth - 36, 16, screenWidth - 22, 16, Colors::UI::BUTTON_SHADOW);  // Drawing bottom edge (black)
-  canvas.drawRect(screenWidth - 32, 7, 7, 6, Colors::UI::BUTTON_TEXT);                     // Drawing □
+  target.fillRect(screenWidth - 36, 3, 15, 14, Colors::UI::BUTTON_BACK);
+  target.drawLine(screenWidth - 36, 3, screenWidth - 22, 3, Colors::UI::BUTTON_LIGHT);     // Drawing top edge (white)
+  target.drawLine(screenWidth - 36, 3, screenWidth - 36, 16, Colors::UI::BUTTON_LIGHT);    // Drawing left edge (white)
+  target.drawLine(screenWidth - 22, 3, screenWidth - 22, 16, Colors::UI::BUTTON_SHADOW);   // Drawing right edge (black)
+  target.drawLine(screenWidth - 36, 16, screenWidth - 22, 16, Colors::UI::BUTTON_SHADOW);  // Drawing bottom edge (black)
+  target.drawRect(screenWidth - 32, 7, 7, 6, Colors::UI::BUTTON_TEXT);                     // Drawing □
   
   // Minimize button
-  canvas.fillRect(screenWidth - 54, 3, 15, 14, Colors::UI::BUTTON_BACK);
-  canvas.drawLine(screenWidth - 54, 3, screenWidth - 40, 3, Colors::UI::BUTTON_LIGHT);     // Drawing top edge (white)
-  canvas.drawLine(screenWidth - 54, 3, screenWidth - 54, 16, Colors::UI::BUTTON_LIGHT);    // Drawing left edge (white)
-  canvas.drawLine(screenWidth - 40, 3, screenWidth - 40, 16, Colors::UI::BUTTON_SHADOW);   // Drawing right edge (black)
-  canvas.drawLine(screenWidth - 54, 16, screenWidth - 40, 16, Colors::UI::BUTTON_SHADOW);  // Drawing bottom edge (black)
-  canvas.drawLine(screenWidth - 50, 12, screenWidth - 44, 12, Colors::UI::BUTTON_TEXT);    // Drawing _
+  target.fillRect(screenWidth - 54, 3, 15, 14, Colors::UI::BUTTON_BACK);
+  target.drawLine(screenWidth - 54, 3, screenWidth - 40, 3, Colors::UI::BUTTON_LIGHT);     // Drawing top edge (white)
+  target.drawLine(screenWidth - 54, 3, screenWidth - 54, 16, Colors::UI::BUTTON_LIGHT);    // Drawing left edge (white)
+  target.drawLine(screenWidth - 40, 3, screenWidth - 40, 16, Colors::UI::BUTTON_SHADOW);   // Drawing right edge (black)
+  target.drawLine(screenWidth - 54, 16, screenWidth - 40, 16, Colors::UI::BUTTON_SHADOW);  // Drawing bottom edge (black)
+  target.drawLine(screenWidth - 50, 12, screenWidth - 44, 12, Colors::UI::BUTTON_TEXT);    // Drawing _
   
   // Title text
-  canvas.setTextColor(Colors::UI::TITLE_BAR_TEXT);
-  canvas.setTextSize(1);
-  canvas.setCursor(5, 6);
-  canvas.print("Defragmenting Drive C");
+  target.setTextColor(Colors::UI::TITLE_BAR_TEXT);
+  target.setTextSize(1);
+  target.setCursor(5, 6);
+  const char* title = "Defragmenting Drive C";
+  target.print(title);
+  
+  // Fragmentation analysis, right-aligned before the buttons once the drive has been read
+  // (fragmented files and free extents; fragments per file and sizes when the title bar is wide enough)
+  if (snapshot->state == AnimationState::DEFRAGMENTING || snapshot->state == AnimationState::CONSOLIDATING ||
+      snapshot->state == AnimationState::COMPLETED) {
+    const FragmentationSummary& summary = snapshot->fragmentation;
+    int fragmentsPerFile = (int)(summary.getFragmentsPerFile() * 10.0f + 0.5f);  // In tenths
+    int fragmentSize = (int)(summary.getAverageFragmentSize() * 10.0f + 0.5f);  // In tenths
+    char analysis[80];
+    snprintf(analysis, sizeof(analysis), "Frag %d%% (%d.%d/file, %d.%d blk)  Free %d ext, max %d",
+             summary.getFragmentedFilePercentage(), fragmentsPerFile / 10, fragmentsPerFile % 10,
+             fragmentSize / 10, fragmentSize % 10, summary.freeExtentCount, summary.largestFreeExtent);
+    int analysisRight = screenWidth - 60;
+    int titleRight = 5 + (int)strlen(title) * 6 + 12;  // End of the title text and a gap
+    if (analysisRight - (int)strlen(analysis) * 6 < titleRight) {
+      snprintf(analysis, sizeof(analysis), "Frag %d%% Gaps %d",
+               summary.getFragmentedFilePercentage(), summary.freeExtentCount);
+    }
+    if (analysisRight - (int)strlen(analysis) * 6 >= titleRight) {
+      target.setCursor(analysisRight - (int)strlen(analysis) * 6, 6);
+      target.print(analysis);
+    }
+  }
   
   // Status area at the bottom
   // Calculate from bottom of screen instead of grid bottom
@@ -78,27 +141,56 @@ void UIRenderer::drawUI() {
   int percentageY = screenHeight - 18;   // 18 pixels from bottom for percentage
   
   // Status message
-  canvas.setTextColor(Colors::UI::BUTTON_TEXT);
-  canvas.setCursor(5, statusY);
+  target.setTextColor(Colors::UI::BUTTON_TEXT);
+  target.setCursor(5, statusY);
   
-  switch (state) {
+  switch (snapshot->state) {
     case AnimationState::READING_DRIVE_INFO_PHASE1:
     case AnimationState::READING_DRIVE_INFO_PHASE2:
-      canvas.print("Reading drive information...");
+      target.print("Reading drive information...");
       break;
     case AnimationState::DEFRAGMENTING:
-      canvas.print("Defragmenting file system...");
+      target.print("Defragmenting file system...");
+      break;
+    case AnimationState::CONSOLIDATING:
+      target.print("Consolidating free space...");
       break;
     case AnimationState::COMPLETED:
-      canvas.print("Defragmentation completed.");
+      target.print("Defragmentation completed.");
       break;
     case AnimationState::TOUCHED:
-      canvas.print("The drive was damaged!!!");
+      target.print("The drive was damaged!!!");
       break;
   }
   
+  // Turbo factor (only when faster than real time)
+  if (turboFactor > 1) {
+    target.print(" (");
+    target.print(turboFactor);
+    target.print("x)");
+  }
+  
+  // Time the copies take on the drive (right-aligned: throughput and time left while copying, total time when done)
+  bool isCopying = (snapshot->state == AnimationState::DEFRAGMENTING || snapshot->state == AnimationState::CONSOLIDATING);
+  char diskStatus[32];
+  diskStatus[0] = '\0';
+  if (isCopying && snapshot->diskThroughput > 0) {
+    uint32_t remainingSeconds = (uint32_t)(snapshot->diskRemainingTime / 1000000);
+    snprintf(diskStatus, sizeof(diskStatus), "%u.%uMB/s ETA %u:%02u",
+             (unsigned)(snapshot->diskThroughput / 1000000), (unsigned)(snapshot->diskThroughput / 100000 % 10),
+             (unsigned)(remainingSeconds / 60), (unsigned)(remainingSeconds % 60));
+  } else if (snapshot->state == AnimationState::COMPLETED && snapshot->diskElapsedTime > 0) {
+    uint32_t elapsedSeconds = (uint32_t)(snapshot->diskElapsedTime / 1000000);
+    snprintf(diskStatus, sizeof(diskStatus), "Disk time %u:%02u",
+             (unsigned)(elapsedSeconds / 60), (unsigned)(elapsedSeconds % 60));
+  }
+  if (diskStatus[0] != '\0') {
+    target.setCursor(screenWidth - 5 - (int)strlen(diskStatus) * 6, statusY);
+    target.print(diskStatus);
+  }
+  
   // Progress bar
-  canvas.drawRect(Config::getProgressBarOffsetX(), progressBarY, Config::getProgressBarWidth(), Config::getProgressBarHeight(), Colors::UI::PROGRESS_FRAME);
+  target.drawRect(Config::getProgressBarOffsetX(), progressBarY, Config::getProgressBarWidth(), Config::getProgressBarHeight(), Colors::UI::PROGRESS_FRAME);
   
   // Calculate number of blocks based on percentage
   // First calculate the maximum number of blocks that can fit
@@ -106,52 +198,150 @@ void UIRenderer::drawUI() {
   int maxBlocks = (progressBarInnerWidth + Config::getProgressBarBlockSpacing() - Config::getProgressBarBlockWidth()) / Config::getProgressBarBlockSpacing();
   
   // Calculate how many blocks to show based on percentage
-  int blocksToShow = (completionPercentage * maxBlocks + 99) / 100;  // +99 for rounding up
+  int blocksToShow = (snapshot->completionPercentage * maxBlocks + 99) / 100;  // +99 for rounding up
   
   // Fill the progress bar (blue blocks)
   for (int i = 0; i < blocksToShow; i++) {
     int blockX = Config::getProgressBarOffsetX() + 2 + i * Config::getProgressBarBlockSpacing();  // +2 for padding
-    canvas.fillRect(blockX, progressBarY + 2, 
+    target.fillRect(blockX, progressBarY + 2, 
                    Config::getProgressBarBlockWidth(), Config::getProgressBarBlockHeight(), Colors::UI::PROGRESS_BLOCK);
   }
   
   // Completion percentage
-  canvas.setCursor(5, percentageY);
-  canvas.print(completionPercentage);
-  canvas.print("% Complete");
+  target.setCursor(5, percentageY);
+  target.print(snapshot->completionPercentage);
+  target.print("% Complete");
+  
+  // Size of the compaction plan (known before the first move starts)
+  if (snapshot->plannedMoveCount >= 0 &&
+      (snapshot->state == AnimationState::DEFRAGMENTING || snapshot->state == AnimationState::COMPLETED)) {
+    target.print("  (");
+    target.print(snapshot->plannedMoveCount);
+    target.print(" moves, ");
+    target.print(snapshot->plannedBlockCount);
+    target.print(" blocks)");
+  }
+  
+  // Fragmentation of the free space while consolidating it (the same extents as the title bar)
+  if (snapshot->state == AnimationState::CONSOLIDATING) {
+    target.print("  (free ");
+    target.print(snapshot->fragmentation.getFreeSpaceFragmentation());
+    target.print("% fragmented)");
+  }
+  
+  // Occupancy of the staging buffers while copying
+  if (snapshot->bufferCapacity > 0 && isCopying) {
+    target.setCursor(screenWidth - 80, percentageY);
+    target.print("Buf ");
+    target.print(snapshot->bufferUsedBlocks);
+    target.print("/");
+    target.print(snapshot->bufferCapacity);
+  }
+  
+  // Change of the head travel of the access trace once done (negative: the workload seeks less)
+  if (snapshot->traceSeekDistanceBefore > 0 && snapshot->state == AnimationState::COMPLETED) {
+    int64_t change = ((int64_t)snapshot->traceSeekDistanceAfter - (int64_t)snapshot->traceSeekDistanceBefore) * 100 /
+                     (int64_t)snapshot->traceSeekDistanceBefore;
+    char seekStatus[16];
+    snprintf(seekStatus, sizeof(seekStatus), "Seek %+d%%", (int)change);
+    target.setCursor(screenWidth - 5 - (int)strlen(seekStatus) * 6, percentageY);
+    target.print(seekStatus);
+  }
 }
 
 // Draw hit counter
 void UIRenderer::drawHitCounter() {
   // Hit counter
-  canvas.setTextColor(Colors::UI::HIT_COUNTER);
-  canvas.setTextSize(2);
-  canvas.setCursor(screenWidth / 2 - 35, screenHeight / 2 - 10);
-  canvas.print(hitCounter);
-  if (hitCounter == 1) {
-    canvas.print(" Hit!");
+  target.setTextColor(Colors::UI::HIT_COUNTER);
+  target.setTextSize(2);
+  target.setCursor(screenWidth / 2 - 35, screenHeight / 2 - 10);
+  target.print(snapshot->hitCounter);
+  if (snapshot->hitCounter == 1) {
+    target.print(" Hit!");
   } else {
-    canvas.print(" Hits!");
+    target.print(" Hits!");
+  }
+
+  if (snapshot->hitCounter >= 10) {
+    target.setCursor(screenWidth / 2 - 35, screenHeight / 2 + 20);
+    target.print("GREAT!");
+  }
+  
+  // Input-to-photon latency of the last touch (only for touches sampled by InputManager)
+  if (inputLatency > 0) {
+    target.setTextSize(1);
+    target.setCursor(screenWidth / 2 - 35, screenHeight / 2 + 45);
+    target.print("Latency: ");
+    target.print((int)(inputLatency / 1000));
+    target.print(" ms");
+  }
+}
+
+// Draw all blocks and explosion debris into a drawing target
+void UIRenderer::drawBlocksTo(RenderTarget& blockTarget) {
+  const RenderSnapshot& frame = *snapshot;
+  size_t movingIndex = 0;
+  
+  for (int y = 0; y < frame.rowCount; y++) {
+    for (int x = 0; x < frame.columnCount; x++) {
+      uint8_t code = frame.blockStates[y * frame.columnCount + x];
+      BlockState blockState = static_cast<BlockState>(code & ~RenderSnapshot::MOVING_FLAG);
+      
+      if (code & RenderSnapshot::MOVING_FLAG) {
+        // Use floating-point coordinates interpolated between ticks during movement animation
+        const MovingBlockSnapshot& moving = frame.movingBlocks[movingIndex++];
+        Block::draw(blockTarget, blockState,
+                    moving.prevX + (moving.x - moving.prevX) * interpolationAlpha,
+                    moving.prevY + (moving.y - moving.prevY) * interpolationAlpha);
+      } else {
+        Block::draw(blockTarget, blockState, x, y);
+      }
+    }
   }
+  
+  frame.particles.draw(blockTarget, interpolationAlpha);
+}
 
-  if (hitCounter >= 10) {
-    canvas.setCursor(screenWidth / 2 - 35, screenHeight / 2 + 20);
-    canvas.print("GREAT!");
+// Draw blocks
+void UIRenderer::drawBlocks() {
+#ifndef ARDUINO
+  // Split the canvas into horizontal tiles and rasterize them in parallel.
+  // Each tile is a view of the canvas memory and blocks are drawn in the same
+  // order as the serial path, so the result is byte-identical
+  // (RegressionHarness --differential compares the two byte for byte).
+  int tileCount = rasterPool.getThreadCount();
+  if (tileCount > 1) {
+    int tileHeight = (target.getHeight() + tileCount - 1) / tileCount;
+    rasterPool.run(tileCount, [&](int i) {
+      int tileY = i * tileHeight;
+      int h = std::min(tileHeight, target.getHeight() - tileY);
+      M5Canvas& tileCanvas = *tileCanvases[i];
+      if (!target.createTileCanvas(tileCanvas, target.getOriginY() + tileY, h)) {
+        return;
+      }
+      RenderTarget tileTarget(tileCanvas);
+      tileTarget.setOrigin(target.getOriginX(), target.getOriginY() + tileY);
+      drawBlocksTo(tileTarget);
+    });
+    return;
   }
+#endif
+
+  drawBlocksTo(target);
 }
 
-// Draw grid and UI elements
-void UIRenderer::draw(GridManager& gridManager, AnimationManager& animationManager) {
+// Draw the scene into the current band of the canvas
+void UIRenderer::drawScene() {
   // Clear the canvas
-  canvas.fillScreen(Colors::UI::WINDOW_BACK);
+  target.fillScreen(Colors::UI::WINDOW_BACK);
   
   // Fill the grid area background with white
-  canvas.fillRect(Config::getGridOffsetX() - 3, Config::getGridOffsetY() - 3, 
+  target.fillRect(Config::getGridOffsetX() - 3, Config::getGridOffsetY() - 3, 
                  Config::getGridCols() * (Config::getBlockWidth() + 2) + 4, 
                  Config::getGridRows() * (Config::getBlockHeight() + 2) + 4, Colors::UI::GRID_BACK);
   
   // Grid area frame
-  canvas.drawRect(Config::getGridOffsetX() - 3, Config::getGridOffsetY() - 3, 
+  target.drawRect(Config::getGridOffsetX() - 3, Config::getGridOffsetY() - 3, 
                  Config::getGridCols() * (Config::getBlockWidth() + 2) + 4, 
                  Config::getGridRows() * (Config::getBlockHeight() + 2) + 4, Colors::UI::GRID_FRAME);
   
@@ -159,19 +349,53 @@ void UIRenderer::draw(GridManager& gridManager, AnimationManager& animationManag
   drawUI();
 
   // Draw blocks
-  for (int y = 0; y < gridManager.getRowCount(); y++) {
-    for (int x = 0; x < gridManager.getColumnCount(); x++) {
-      gridManager.getBlock(x, y).draw(state);
-    }
-  }
+  drawBlocks();
 
   // Draw hit counter
-  if (state == AnimationState::TOUCHED) {
+  if (snapshot->state == AnimationState::TOUCHED) {
     drawHitCounter();
   }
+}
+
+// Draw grid and UI elements from a snapshot
+void UIRenderer::draw(const RenderSnapshot& frameSnapshot, float alpha) {
+  snapshot = &frameSnapshot;
+  interpolationAlpha = alpha;
   
-  // Transfer canvas content to display
-  canvas.pushSprite(0, 0);  
+  // Draw and transfer the screen band by band
+  // (a full-screen canvas is a single band)
+  int bandHeight = target.getHeight();
+  if (bandHeight <= 0) {
+    // No canvas was allocated: there is nothing to draw into
+    snapshot = nullptr;
+    return;
+  }
+  for (int bandY = 0; bandY < screenHeight; bandY += bandHeight) {
+    target.setOrigin(0, bandY);
+    drawScene();
+    
+    // Transfer canvas content to display
+    target.pushSprite();
+  }
+  target.setOrigin(0, 0);
+  snapshot = nullptr;
+}
+
+// Copy the status into a snapshot
+void UIRenderer::captureStatus(RenderSnapshot& frameSnapshot) const {
+  frameSnapshot.state = state;
+  frameSnapshot.completionPercentage = completionPercentage;
+  frameSnapshot.hitCounter = hitCounter;
+  frameSnapshot.plannedMoveCount = plannedMoveCount;
+  frameSnapshot.plannedBlockCount = plannedBlockCount;
+  frameSnapshot.bufferUsedBlocks = bufferUsedBlocks;
+  frameSnapshot.bufferCapacity = bufferCapacity;
+  frameSnapshot.diskElapsedTime = diskElapsedTime;
+  frameSnapshot.diskThroughput = diskThroughput;
+  frameSnapshot.diskRemainingTime = diskRemainingTime;
+  frameSnapshot.traceSeekDistanceBefore = traceSeekDistanceBefore;
+  frameSnapshot.traceSeekDistanceAfter = traceSeekDistanceAfter;
+  frameSnapshot.fragmentation = fragmentation;
 }
 
 // Set state
@@ -203,3 +427,48 @@ void UIRenderer::incrementHitCounter() {
 int UIRenderer::getHitCounter() const {
   return hitCounter;
 }
+
+// Reset hit counter
+void UIRenderer::resetHitCounter() {
+  hitCounter = 0;
+}
+
+// Set the size of the compaction plan
+void UIRenderer::setPlanSummary(int moveCount, int blockCount) {
+  plannedMoveCount = moveCount;
+  plannedBlockCount = blockCount;
+}
+
+// Set the occupancy of the staging buffers
+void UIRenderer::setBufferOccupancy(int usedBlocks, int capacity) {
+  bufferUsedBlocks = usedBlocks;
+  bufferCapacity = capacity;
+}
+
+// Set the time the copies take on the drive
+void UIRenderer::setDiskStatus(uint64_t elapsedTime, uint64_t throughput, uint64_t remainingTime) {
+  diskElapsedTime = elapsedTime;
+  diskThroughput = throughput;
+  diskRemainingTime = remainingTime;
+}
+
+// Set the head travel of the access trace before and after defragmenting
+void UIRenderer::setTraceSeekDistances(uint64_t before, uint64_t after) {
+  traceSeekDistanceBefore = before;
+  traceSeekDistanceAfter = after;
+}
+
+// Set the fragmentation of the drive
+void UIRenderer::setFragmentation(const FragmentationSummary& summary) {
+  fragmentation = summary;
+}
+
+// Set turbo factor
+void UIRenderer::setTurboFactor(int factor) {
+  turboFactor = factor;
+}
+
+// Set the measured input-to-photon latency
+void UIRenderer::setInputLatency(uint32_t latency) {
+  inputLatency = latency;
+}
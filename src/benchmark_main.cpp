@@ -0,0 +1,31 @@
+/**
+ * @file benchmark_main.cpp
+ * @brief Main entry point for the native defrag strategy benchmark
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file provides the main entry point for comparing the defrag
+ * strategies without a display. It plans the same seeded drive layouts with
+ * every strategy and with several numbers of defrag heads, and prints tables
+ * of the results (see StrategyBenchmark).
+ * 
+ * Note: This file is only compiled when DEFRAG_BENCHMARK macro is defined.
+ */
+
+#if defined ( DEFRAG_BENCHMARK )
+
+#include "StrategyBenchmark.h"
+
+int main(int argc, char** argv)
+{
+  BenchmarkOptions options;
+  if (!StrategyBenchmark::parseArguments(argc, argv, options)) {
+    return 2;
+  }
+
+  StrategyBenchmark benchmark(options);
+  return benchmark.run();
+}
+
+#endif
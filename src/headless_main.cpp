@@ -0,0 +1,30 @@
+/**
+ * @file headless_main.cpp
+ * @brief Headless main entry point for the golden-image regression harness
+ * @author cubic9com
+ * @date 2025
+ * @copyright Copyright (c) 2025 cubic9com All rights reserved.
+ * 
+ * This file provides the main entry point for running the disk defragmentation
+ * simulator without a display. It runs a seeded simulation and compares
+ * rendered frames against stored golden frames (see RegressionHarness).
+ * 
+ * Note: This file is only compiled when DEFRAG_HEADLESS macro is defined.
+ */
+
+#if defined ( DEFRAG_HEADLESS )
+
+#include "RegressionHarness.h"
+
+int main(int argc, char** argv)
+{
+  RegressionOptions options;
+  if (!RegressionHarness::parseArguments(argc, argv, options)) {
+    return 2;
+  }
+
+  RegressionHarness harness(options);
+  return harness.run();
+}
+
+#endif
@@ -20,16 +20,31 @@
 #include "FileManager.h"
 #include "AnimationManager.h"
 #include "UIRenderer.h"
+#include "RenderTarget.h"
 #include "SoundManager.h"
 #include "DefragSimulator.h"
+#include "FrameScheduler.h"
+#include "InputManager.h"
 #include "PlatformCompat.h"
 
 // Canvas for off-screen rendering
 M5Canvas canvas(&M5.Display);
 
+// Second canvas drawn while the first one is being transferred (double buffering)
+M5Canvas backCanvas(&M5.Display);
+
 // Global instance
 DefragSimulator defragSim;
 
+// Scheduler pacing simulation steps and presents to the frame budget
+FrameScheduler frameScheduler;
+
+// Input sampling (on loop(), between frames)
+InputManager inputManager;
+
+// Whether the simulation runs on its own task (loop() runs it with runFrame otherwise)
+bool simulationTaskRunning = false;
+
 void setup() {
   auto cfg = M5.config();
   M5.begin(cfg);
@@ -41,31 +56,53 @@ void setup() {
   // Initialize Config with screen dimensions
   Config::getInstance()->initialize(M5.Display.width(), M5.Display.height());
   
-  // Initialize canvas (same size as screen)
-  canvas.createSprite(M5.Display.width(), M5.Display.height());
+  // Initialize canvas (same size as screen, palettized per Config::Render)
+  // Without enough memory nothing can be drawn, so say so on the display and stop
+  if (!RenderTarget::createCanvases(canvas, backCanvas, M5.Display.width(), M5.Display.height())) {
+    M5.Display.endWrite();
+    M5.Display.setCursor(0, 0);
+    M5.Display.print("Not enough memory for the canvas");
+    while (true) {
+      delay(1000);
+    }
+  }
 
   // Initialize defrag simulator
   defragSim.initialize();
+  
+  // Start frame pacing (in split mode the simulation runs on its own task from here on,
+  // unless the task cannot be created: then loop() keeps running it)
+  frameScheduler.reset();
+  if (Config::Scheduler::SPLIT_SIMULATION) {
+    simulationTaskRunning = frameScheduler.startSimulationTask(defragSim);
+  }
+  
+  // Touches and button B clicks go to the simulator
+  inputManager.begin(defragSim);
 }
 
 void loop() {
-  M5.update();
-  
-  // Check touch events
-  if (M5.Touch.getCount() > 0) {
-    auto touch = M5.Touch.getDetail();
-    if (touch.wasPressed()) {
-      // Process when touch is detected
-      defragSim.handleTouch(touch.x, touch.y);
+  // Sample touch and buttons here: M5.update() drives the shared internal I2C bus
+  // (touch and power chip), so it must stay on this one thread
+  inputManager.sample();
+
+  // Cycle turbo factor (1x/4x/16x simulation steps per tick) with button A
+  // (touches go to the simulator directly)
+  InputEvent event;
+  while (inputManager.pollButtonEvent(event)) {
+    if (event.type == InputEventType::BUTTON_A_CLICKED) {
+      frameScheduler.cycleTurboFactor();
+      defragSim.setTurboFactor(frameScheduler.getTurboFactor());
     }
   }
 
-  // Update process
-  defragSim.update();
-  
-  // Draw to canvas
-  defragSim.draw();
-  
-  // Add a slight delay (adjust animation speed)
-  delay(1);
+  if (simulationTaskRunning) {
+    // Draw the latest snapshot from the simulation task (idle while nothing changes)
+    if (!defragSim.drawLatestSnapshot()) {
+      delay(1);
+    }
+  } else {
+    // Run due simulation steps and draw to canvas within the frame budget
+    frameScheduler.runFrame(defragSim);
+  }
 }
@@ -11,10 +11,12 @@
  * 
  * Note: This file is only compiled when SDL_h_ macro is defined.
  * For actual M5Stack hardware, main.cpp is used instead.
+ * For headless runs (DEFRAG_HEADLESS), headless_main.cpp is used instead.
+ * For the strategy benchmark (DEFRAG_BENCHMARK), benchmark_main.cpp is used instead.
  */
 
 #include <M5GFX.h>
-#if defined ( SDL_h_ )
+#if defined ( SDL_h_ ) && !defined ( DEFRAG_HEADLESS ) && !defined ( DEFRAG_BENCHMARK )
 
 void setup(void);
 void loop(void);
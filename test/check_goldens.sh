@@ -0,0 +1,29 @@
+#!/bin/sh
+# Check the headless simulation against the golden files in this directory
+#
+#   test/check_goldens.sh           compare (exits non-zero on a mismatch)
+#   test/check_goldens.sh --record  record new goldens after an intended change
+#
+# golden_grid.txt hashes the simulated grid, so it holds for any M5GFX build
+# (it was recorded with libstdc++; other standard libraries may draw other random layouts).
+# golden_frames.txt hashes the rendered frames, which depend on the M5GFX build:
+# it is only checked once it has been recorded with --record.
+set -e
+cd "$(dirname "$0")/.."
+
+pio run -e native-headless
+PROGRAM=.pio/build/native-headless/program
+FRAMES=$(seq -s, 100 100 3000)
+
+"$PROGRAM" --grid --metrics --frames "$FRAMES" --golden test/golden_grid.txt "$@"
+
+# Rendering: each checkpoint drawn through the palettized, configured and banded setups
+# must match the reference setup (16-bit, one full-screen canvas, serial rasterization),
+# and tile-parallel rasterization must match serial rasterization byte for byte
+# (the touch at frame 2000 throws explosion debris across the tiles for the frames after it)
+if [ "$1" != "--record" ]; then
+  "$PROGRAM" --differential --frames "$FRAMES,2002,2004,2006,2008,2010,2012" --touch 2000,160,120
+fi
+if [ "$1" = "--record" ] || [ -f test/golden_frames.txt ]; then
+  "$PROGRAM" --frames "$FRAMES" --golden test/golden_frames.txt "$@"
+fi